@@ -0,0 +1,77 @@
+// atomic.cpp — AtomicRefined CAS updates versus a mutex-guarded counter
+//
+// Each thread repeatedly acquires and releases one unit of a counter
+// bounded to [0, limit], so every update must keep the value inside the
+// interval. The baseline guards a plain int with std::mutex and validates
+// the new value before committing it; AtomicRefined does the same check
+// inside a compare-and-swap loop. Runs from 1 thread to the hardware
+// concurrency.
+//
+// Usage: bench_atomic [operations-in-Mi-per-thread]   (default 1)
+
+#include <refinery/atomic.hpp>
+#include <refinery/interval.hpp>
+
+#include <mutex>
+
+#include "bench.hpp"
+
+using namespace refinery;
+
+namespace {
+
+constexpr int limit = 1 << 20;
+using Count = IntervalRefined<int, 0, limit>;
+
+class MutexCounter {
+    std::mutex mutex_;
+    int value_ = 0;
+
+  public:
+    bool add(int delta) {
+        std::lock_guard lock(mutex_);
+        int next = value_ + delta;
+        if (!Count::predicate(next))
+            return false;
+        value_ = next;
+        return true;
+    }
+    int get() {
+        std::lock_guard lock(mutex_);
+        return value_;
+    }
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t ops = bench::size_arg_mib(argc, argv, 1) << 20;
+
+    for (unsigned threads : bench::thread_counts()) {
+        const std::size_t total = ops * threads;
+        std::printf("%u thread%s\n", threads, threads == 1 ? "" : "s");
+
+        MutexCounter locked;
+        double s = bench::time_threads(threads, [&](unsigned) {
+            for (std::size_t i = 0; i < ops; ++i) {
+                if (locked.add(1))
+                    locked.add(-1);
+            }
+        });
+        if (locked.get() != 0)
+            std::printf("mutex counter did not return to zero\n");
+        bench::report_rate("std::mutex + check", s, total);
+
+        AtomicRefined<int, Count::predicate> atomic{Count{0}};
+        s = bench::time_threads(threads, [&](unsigned) {
+            for (std::size_t i = 0; i < ops; ++i) {
+                if (atomic.fetch_add(1))
+                    atomic.fetch_sub(1);
+            }
+        });
+        if (atomic.load().get() != 0)
+            std::printf("atomic counter did not return to zero\n");
+        bench::report_rate("AtomicRefined fetch_add/fetch_sub", s, total);
+    }
+    return 0;
+}
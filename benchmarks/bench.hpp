@@ -0,0 +1,97 @@
+// bench.hpp - Minimal timing harness for refinery benchmarks
+// Part of the C++26 Refinement Types Library
+//
+// No external dependencies: each benchmark is a plain executable that times
+// a callable with std::chrono, keeps the best of several repetitions and
+// prints one line per measurement.
+
+#ifndef REFINERY_BENCH_HPP
+#define REFINERY_BENCH_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <latch>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace bench {
+
+// Prevent the optimizer from discarding a computed value
+template <typename T> inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Best wall-clock time of `reps` calls to fn, in seconds
+template <typename F> double best_of(int reps, F&& fn) {
+    double best = 1e300;
+    for (int r = 0; r < reps; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto stop = std::chrono::steady_clock::now();
+        best = std::min(best,
+                        std::chrono::duration<double>(stop - start).count());
+    }
+    return best;
+}
+
+// Wall-clock time, in seconds, for `threads` threads that each run
+// fn(thread_index) after all of them have started
+template <typename F> double time_threads(unsigned threads, F&& fn) {
+    std::latch ready(threads + 1);
+    std::vector<std::jthread> pool;
+    pool.reserve(threads);
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            ready.arrive_and_wait();
+            fn(t);
+        });
+    }
+    auto start = std::chrono::steady_clock::now();
+    ready.arrive_and_wait();
+    pool.clear();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count();
+}
+
+// Thread counts 1, 2, 4, ... up to the hardware concurrency (and at most
+// `limit`), always ending with the hardware concurrency itself
+inline std::vector<unsigned> thread_counts(unsigned limit = 64) {
+    unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    hw = std::min(hw, limit);
+    std::vector<unsigned> counts;
+    for (unsigned n = 1; n < hw; n *= 2)
+        counts.push_back(n);
+    counts.push_back(hw);
+    return counts;
+}
+
+// Print throughput for a pass over `bytes` bytes
+inline void report_throughput(std::string_view name, double seconds,
+                              std::size_t bytes) {
+    std::printf("%-40.*s %10.3f ms %8.2f GB/s\n",
+                static_cast<int>(name.size()), name.data(), seconds * 1e3,
+                static_cast<double>(bytes) / seconds / 1e9);
+}
+
+// Print per-item latency for a pass over `items` items
+inline void report_rate(std::string_view name, double seconds,
+                        std::size_t items) {
+    std::printf("%-40.*s %10.3f ms %8.2f ns/item\n",
+                static_cast<int>(name.size()), name.data(), seconds * 1e3,
+                seconds * 1e9 / static_cast<double>(items));
+}
+
+// Size argument in MiB from argv[1], or `fallback`
+inline std::size_t size_arg_mib(int argc, char** argv, std::size_t fallback) {
+    if (argc > 1)
+        return static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10));
+    return fallback;
+}
+
+} // namespace bench
+
+#endif // REFINERY_BENCH_HPP
@@ -0,0 +1,100 @@
+// bounded.cpp — heap containers versus BoundedVector/BoundedString
+//
+// Builds order messages (a symbol of up to 8 characters and up to 6 tags of
+// up to 12 characters) one at a time, as a gateway would before
+// serializing each one. The baseline uses std::string and
+// std::vector<std::string>; the bounded version keeps everything inline.
+// Reports latency per message and heap allocations per message, counted
+// by replacing the global operator new.
+//
+// Usage: bench_bounded [messages-in-Mi]   (default 2)
+
+#include <refinery/bounded.hpp>
+#include <refinery/refinery.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace {
+std::size_t allocations = 0;
+}
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+using namespace refinery;
+
+namespace {
+
+constexpr std::array<std::string_view, 8> symbols = {
+    "AAPL", "MSFT", "GOOGL", "AMZN", "BRK.B", "NVDA", "TSLA", "META"};
+constexpr std::array<std::string_view, 8> tags = {
+    "iceberg", "post-only", "ioc",      "hidden",
+    "retail",  "algo:twap", "desk:eq1", "short-exempt"};
+
+struct HeapOrder {
+    std::string symbol;
+    std::vector<std::string> tags;
+};
+
+struct InlineOrder {
+    BoundedString<8> symbol;
+    BoundedVector<BoundedString<12>, 6> tags;
+};
+
+template <typename Order, typename AddTag>
+double run(std::size_t messages, AddTag add_tag) {
+    return bench::best_of(3, [&] {
+        for (std::size_t i = 0; i < messages; ++i) {
+            Order order;
+            order.symbol.append(symbols[i % symbols.size()]);
+            const std::size_t count = i % 7;
+            for (std::size_t t = 0; t < count; ++t)
+                add_tag(order, tags[(i + t) % tags.size()]);
+            bench::do_not_optimize(order);
+        }
+    });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t messages = bench::size_arg_mib(argc, argv, 2) << 20;
+
+    std::size_t before = allocations;
+    double heap_s = run<HeapOrder>(messages, [](HeapOrder& o,
+                                                std::string_view tag) {
+        o.tags.emplace_back(tag);
+    });
+    const double heap_allocs =
+        static_cast<double>(allocations - before) / (3.0 * messages);
+
+    before = allocations;
+    double inline_s = run<InlineOrder>(messages, [](InlineOrder& o,
+                                                    std::string_view tag) {
+        o.tags.unchecked_push_back(*BoundedString<12>::from(tag));
+    });
+    const double inline_allocs =
+        static_cast<double>(allocations - before) / (3.0 * messages);
+
+    bench::report_rate("std::string + std::vector", heap_s, messages);
+    bench::report_rate("BoundedString + BoundedVector", inline_s, messages);
+    std::printf("allocations per message: %.2f heap, %.2f inline\n",
+                heap_allocs, inline_allocs);
+    return 0;
+}
@@ -0,0 +1,108 @@
+// bulk.cpp — parallel bulk validation, scaling from 1 to N threads
+//
+// Runs all_valid, count_invalid, partition_valid and refine_all over the
+// same array on WorkStealingPools of 1, 2, 4, ... hardware-concurrency
+// threads. Two refinements are used: PositiveI32, which is memory bound,
+// and a Luhn check-digit predicate, which is compute bound. The last rows
+// put one invalid value at the front of the array, so all_valid measures
+// how quickly cancellation stops the other threads.
+//
+// Usage: bench_bulk [count-in-Mi-values]   (default 32)
+
+#include <refinery/bulk.hpp>
+#include <refinery/refinery.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+
+using namespace refinery;
+
+namespace {
+
+// Decimal digits of v, read as a card number, pass the Luhn check
+constexpr auto LuhnValid = [](std::int32_t v) constexpr {
+    if (v <= 0)
+        return false;
+    int sum = 0;
+    bool doubled = false;
+    for (; v > 0; v /= 10, doubled = !doubled) {
+        int d = v % 10;
+        if (doubled)
+            d = d * 2 > 9 ? d * 2 - 9 : d * 2;
+        sum += d;
+    }
+    return sum % 10 == 0;
+};
+using Account = Refined<std::int32_t, LuhnValid>;
+
+template <typename F>
+void run(std::string_view op, unsigned threads, std::size_t n, F&& fn) {
+    std::size_t result = 0;
+    double s = bench::best_of(3, [&] {
+        result = fn();
+        bench::do_not_optimize(result);
+    });
+    std::string name = std::string(op) + " t=" + std::to_string(threads);
+    bench::report_rate(name, s, n);
+}
+
+template <typename R>
+void scaling(std::string_view title, std::span<const std::int32_t> values) {
+    std::printf("%.*s\n", static_cast<int>(title.size()), title.data());
+    const std::size_t n = values.size();
+    for (unsigned t : bench::thread_counts()) {
+        WorkStealingPool pool(t);
+        run("all_valid", t, n, [&] {
+            return std::size_t{all_valid<R>(pool, values)};
+        });
+        run("count_invalid", t, n,
+            [&] { return count_invalid<R>(pool, values); });
+        run("partition_valid", t, n, [&] {
+            return partition_valid<R>(pool, values).values.size();
+        });
+        run("refine_all", t, n, [&] {
+            auto all = refine_all<R>(pool, values);
+            return all ? all->size() : 0;
+        });
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t count = bench::size_arg_mib(argc, argv, 32) << 20;
+
+    std::vector<std::int32_t> values(count);
+    std::uint32_t state = 12345;
+    for (auto& v : values) {
+        state = state * 1664525u + 1013904223u;
+        v = static_cast<std::int32_t>(1 + (state >> 2) % 1'000'000'000);
+    }
+    scaling<PositiveI32>("PositiveI32 (all valid)", values);
+
+    // Make every value pass the Luhn check by fixing its last digit
+    for (auto& v : values) {
+        std::int32_t base = v / 10 * 10;
+        for (std::int32_t d = 0; d < 10; ++d) {
+            if (LuhnValid(base + d)) {
+                v = base + d;
+                break;
+            }
+        }
+    }
+    scaling<Account>("Luhn check digit (all valid)", values);
+
+    values.front() = -1;
+    std::printf("first value invalid\n");
+    for (unsigned t : bench::thread_counts()) {
+        WorkStealingPool pool(t);
+        run("all_valid", t, count, [&] {
+            return std::size_t{all_valid<Account>(
+                pool, std::span<const std::int32_t>(values))};
+        });
+    }
+    return 0;
+}
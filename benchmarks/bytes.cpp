@@ -0,0 +1,163 @@
+// bytes.cpp — bounds-checked cursor versus RefinedBytes packet parsing
+//
+// Walks a buffer of back-to-back packets, each a 12-byte big-endian header
+// (version, kind, port, sequence, payload length, flags) followed by 16 to
+// 79 payload bytes, and sums a few fields. The baseline checks
+// `offset + n <= size` before every read; the RefinedBytes parser checks
+// once that the header is present and once that the payload fits.
+//
+// Usage: bench_bytes [buffer-size-in-MiB]   (default 64)
+
+#include <refinery/bytes.hpp>
+#include <refinery/refinery.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "bench.hpp"
+
+using namespace refinery;
+
+namespace {
+
+constexpr std::size_t header_size = 12;
+
+struct totals {
+    std::uint64_t packets = 0;
+    std::uint64_t sum = 0;
+    bool operator==(const totals&) const = default;
+};
+
+std::vector<std::byte> make_packets(std::size_t bytes) {
+    std::vector<std::byte> out;
+    out.reserve(bytes + 128);
+    std::uint32_t state = 12345;
+    auto next = [&] {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    };
+    auto put = [&](auto value) {
+        value = std::byteswap(value);
+        const auto* p = reinterpret_cast<const std::byte*>(&value);
+        out.insert(out.end(), p, p + sizeof(value));
+    };
+    for (std::uint32_t seq = 0; out.size() < bytes; ++seq) {
+        const auto length = static_cast<std::uint16_t>(16 + next() % 64);
+        out.push_back(std::byte{1});
+        out.push_back(static_cast<std::byte>(next() % 8));
+        put(static_cast<std::uint16_t>(1 + next() % 65535));
+        put(seq);
+        put(length);
+        put(static_cast<std::uint16_t>(next()));
+        for (std::uint16_t i = 0; i < length; ++i)
+            out.push_back(static_cast<std::byte>(next()));
+    }
+    return out;
+}
+
+// Baseline: a cursor that checks the remaining size before every read
+class checked_cursor {
+    std::span<const std::byte> bytes_;
+    std::size_t offset_ = 0;
+
+  public:
+    explicit checked_cursor(std::span<const std::byte> bytes)
+        : bytes_(bytes) {}
+
+    bool done() const { return offset_ == bytes_.size(); }
+
+    template <typename T> std::optional<T> read() {
+        if (offset_ + sizeof(T) > bytes_.size())
+            return std::nullopt;
+        T value;
+        std::memcpy(&value, bytes_.data() + offset_, sizeof(T));
+        offset_ += sizeof(T);
+        if constexpr (sizeof(T) > 1)
+            value = std::byteswap(value);
+        return value;
+    }
+
+    bool skip(std::size_t n) {
+        if (offset_ + n > bytes_.size())
+            return false;
+        offset_ += n;
+        return true;
+    }
+};
+
+totals parse_checked(std::span<const std::byte> buffer) {
+    totals t;
+    checked_cursor cursor(buffer);
+    while (!cursor.done()) {
+        auto version = cursor.read<std::uint8_t>();
+        auto kind = cursor.read<std::uint8_t>();
+        auto port = cursor.read<std::uint16_t>();
+        auto seq = cursor.read<std::uint32_t>();
+        auto length = cursor.read<std::uint16_t>();
+        auto flags = cursor.read<std::uint16_t>();
+        if (!version || !kind || !port || !seq || !length || !flags ||
+            !cursor.skip(*length))
+            break;
+        t.packets += 1;
+        t.sum += *kind + *port + *seq + *flags;
+    }
+    return t;
+}
+
+totals parse_refined(std::span<const std::byte> buffer) {
+    totals t;
+    while (!buffer.empty()) {
+        auto header = refine_bytes<header_size>(buffer);
+        if (!header)
+            break;
+        constexpr auto big = std::endian::big;
+        auto kind = header->read<std::uint8_t, 1>();
+        auto port = header->read<std::uint16_t, 2, big>();
+        auto seq = header->read<std::uint32_t, 4, big>();
+        auto length = header->read<std::uint16_t, 8, big>();
+        auto flags = header->read<std::uint16_t, 10, big>();
+        auto body = header->advance<header_size>().take(length);
+        if (!body)
+            break;
+        t.packets += 1;
+        t.sum += kind + port + seq + flags;
+        buffer = body->second.bytes();
+    }
+    return t;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t bytes = bench::size_arg_mib(argc, argv, 64) << 20;
+    const auto buffer = make_packets(bytes);
+
+    totals checked;
+    totals refined;
+    double checked_s =
+        bench::best_of(5, [&] { checked = parse_checked(buffer); });
+    double refined_s =
+        bench::best_of(5, [&] { refined = parse_refined(buffer); });
+    if (!(checked == refined)) {
+        std::printf("parsers disagree\n");
+        return 1;
+    }
+    bench::do_not_optimize(refined.sum);
+
+    std::printf("%llu packets, %zu bytes\n",
+                static_cast<unsigned long long>(refined.packets),
+                buffer.size());
+    bench::report_rate("checked cursor (ns/packet)", checked_s,
+                       checked.packets);
+    bench::report_rate("RefinedBytes (ns/packet)", refined_s,
+                       refined.packets);
+    bench::report_throughput("checked cursor", checked_s, buffer.size());
+    bench::report_throughput("RefinedBytes", refined_s, buffer.size());
+    return 0;
+}
@@ -0,0 +1,102 @@
+// columnar.cpp — parse_column<R> versus a line-by-line from_chars loop
+//
+// Builds a newline-separated column of integers (about 3% of them out of
+// range or malformed) and one of decimals, then parses each into a refined
+// vector with parse_column and with the split + from_chars + try_refine
+// loop it replaces. Throughput is reported in input bytes per second.
+//
+// Usage: bench_columnar [size-in-MiB]   (default 256; use 1024-10240 for
+//                                        GB-scale runs)
+
+#include <refinery/columnar.hpp>
+#include <refinery/refinery.hpp>
+
+#include <charconv>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+
+using namespace refinery;
+
+namespace {
+
+using Quantity = IntervalRefined<std::int32_t, 0, 1'000'000>;
+
+template <typename R>
+parsed_column<R> line_by_line(std::string_view text) {
+    parsed_column<R> out;
+    std::size_t row = 0;
+    while (!text.empty()) {
+        std::size_t nl = text.find('\n');
+        std::string_view field = text.substr(0, nl);
+        typename R::value_type raw{};
+        const char* end = field.data() + field.size();
+        auto [ptr, ec] = std::from_chars(field.data(), end, raw);
+        auto refined = ec == std::errc{} && ptr == end
+                           ? try_refine<R>(raw)
+                           : std::nullopt;
+        if (refined)
+            out.values.push_back(*refined);
+        else
+            out.rejected.push_back(row);
+        ++row;
+        text.remove_prefix(nl == std::string_view::npos ? text.size()
+                                                        : nl + 1);
+    }
+    return out;
+}
+
+template <typename R, typename F>
+void run(std::string_view name, const std::string& input, F&& fn) {
+    std::size_t rows = 0;
+    double s = bench::best_of(3, [&] {
+        parsed_column<R> col = fn(std::string_view{input});
+        rows = col.values.size() + col.rejected.size();
+        bench::do_not_optimize(col.values.data());
+    });
+    bench::do_not_optimize(rows);
+    bench::report_throughput(name, s, input.size());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t bytes = bench::size_arg_mib(argc, argv, 256) << 20;
+
+    std::string integers;
+    std::string decimals;
+    integers.reserve(bytes + 32);
+    decimals.reserve(bytes + 32);
+    std::uint64_t state = 12345;
+    auto next = [&] {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return state >> 33;
+    };
+    while (integers.size() < bytes) {
+        std::uint64_t r = next();
+        if (r % 32 == 0)
+            integers += "n/a";
+        else
+            integers += std::to_string(r % 1'030'000);
+        integers += '\n';
+    }
+    while (decimals.size() < bytes) {
+        std::uint64_t r = next();
+        decimals += std::to_string(r % 100'000);
+        decimals += '.';
+        decimals += std::to_string(r % 1000);
+        decimals += '\n';
+    }
+
+    run<Quantity>("line-by-line integers", integers, line_by_line<Quantity>);
+    run<Quantity>("parse_column integers", integers,
+                  [](std::string_view t) { return parse_column<Quantity>(t); });
+    run<FiniteF64>("line-by-line decimals", decimals,
+                   line_by_line<FiniteF64>);
+    run<FiniteF64>("parse_column decimals", decimals, [](std::string_view t) {
+        return parse_column<FiniteF64>(t);
+    });
+    return 0;
+}
@@ -0,0 +1,61 @@
+// counter.cpp — BoundedCounter scalability, unsharded and sharded
+//
+// Every thread repeatedly acquires and releases one permit of a counter
+// with N = 4096 permits. Compares an ad-hoc std::atomic counter (fetch_add,
+// then roll back if the bound was exceeded, which lets the count briefly
+// overshoot), BoundedCounter<N> and BoundedCounter<N, 16>, from 1 to 64
+// threads.
+//
+// Usage: bench_counter [operations-in-Mi-per-thread]   (default 1)
+
+#include <refinery/counter.hpp>
+
+#include <atomic>
+
+#include "bench.hpp"
+
+using namespace refinery;
+
+namespace {
+
+constexpr std::size_t permits = 4096;
+
+class AdHocCounter {
+    std::atomic<std::size_t> in_use_{0};
+
+  public:
+    bool try_acquire() {
+        if (in_use_.fetch_add(1, std::memory_order::acquire) >= permits) {
+            in_use_.fetch_sub(1, std::memory_order::relaxed);
+            return false;
+        }
+        return true;
+    }
+    void release() { in_use_.fetch_sub(1, std::memory_order::release); }
+};
+
+template <typename Counter>
+void run(std::string_view name, unsigned threads, std::size_t ops) {
+    Counter counter;
+    double s = bench::time_threads(threads, [&](unsigned) {
+        for (std::size_t i = 0; i < ops; ++i) {
+            if (counter.try_acquire())
+                counter.release();
+        }
+    });
+    bench::report_rate(name, s, ops * threads);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t ops = bench::size_arg_mib(argc, argv, 1) << 20;
+
+    for (unsigned threads = 1; threads <= 64; threads *= 2) {
+        std::printf("%u thread%s\n", threads, threads == 1 ? "" : "s");
+        run<AdHocCounter>("std::atomic fetch_add + rollback", threads, ops);
+        run<BoundedCounter<permits>>("BoundedCounter<N>", threads, ops);
+        run<BoundedCounter<permits, 16>>("BoundedCounter<N, 16>", threads, ops);
+    }
+    return 0;
+}
@@ -0,0 +1,145 @@
+// decode.cpp — decode<S> versus decode-then-validate
+//
+// Decodes a stream of big-endian 24-byte quote records, about 10% of which
+// have one bad field, into a struct of Refined members. The baseline reads
+// every field into a plain struct first and then validates the plain values
+// before wrapping them; decode<S> checks each field as it is loaded.
+//
+// Usage: bench_decode [count-in-Mi-records]   (default 1)
+
+#include <refinery/decode.hpp>
+#include <refinery/refinery.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <vector>
+
+#include "bench.hpp"
+
+using namespace refinery;
+
+namespace {
+
+struct Quote {
+    IntervalRefined<std::uint16_t, 1, 4096> venue;
+    IntervalRefined<std::uint16_t, 1, 1000> lots;
+    NonZeroU32 instrument;
+    PositiveF64 price;
+    [[= check<Interval<0, 86'400'000'000>{}>]] std::int64_t micros;
+};
+
+struct PlainQuote {
+    std::uint16_t venue;
+    std::uint16_t lots;
+    std::uint32_t instrument;
+    double price;
+    std::int64_t micros;
+};
+
+template <typename T> T load_be(const std::byte* p) {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    if constexpr (std::endian::native == std::endian::little) {
+        using U = std::conditional_t<
+            sizeof(T) == 2, std::uint16_t,
+            std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>;
+        value = std::bit_cast<T>(std::byteswap(std::bit_cast<U>(value)));
+    }
+    return value;
+}
+
+template <typename T> void store_be(std::byte* p, T value) {
+    using U = std::conditional_t<
+        sizeof(T) == 2, std::uint16_t,
+        std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>;
+    U bits = std::bit_cast<U>(value);
+    if constexpr (std::endian::native == std::endian::little)
+        bits = std::byteswap(bits);
+    std::memcpy(p, &bits, sizeof(T));
+}
+
+std::optional<Quote> decode_then_validate(const std::byte* p) {
+    PlainQuote q{load_be<std::uint16_t>(p), load_be<std::uint16_t>(p + 2),
+                 load_be<std::uint32_t>(p + 4), load_be<double>(p + 8),
+                 load_be<std::int64_t>(p + 16)};
+    if (q.venue < 1 || q.venue > 4096 || q.lots < 1 || q.lots > 1000 ||
+        q.instrument == 0 || !(q.price > 0) || q.micros < 0 ||
+        q.micros > 86'400'000'000)
+        return std::nullopt;
+    return Quote{decltype(Quote::venue)(q.venue, assume_valid),
+                 decltype(Quote::lots)(q.lots, assume_valid),
+                 NonZeroU32(q.instrument, assume_valid),
+                 PositiveF64(q.price, assume_valid), q.micros};
+}
+
+template <typename F>
+void run(std::string_view name, const std::vector<std::byte>& wire,
+         std::size_t expected, F&& decode_one) {
+    const std::size_t count = wire.size() / wire_size_v<Quote>;
+    std::size_t accepted = 0;
+    double s = bench::best_of(5, [&] {
+        accepted = 0;
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            auto q = decode_one(wire.data() + i * wire_size_v<Quote>);
+            if (q) {
+                ++accepted;
+                sum += q->lots.get();
+            }
+        }
+        bench::do_not_optimize(sum);
+    });
+    if (accepted != expected)
+        std::printf("result mismatch in %.*s: %zu != %zu\n",
+                    static_cast<int>(name.size()), name.data(), accepted,
+                    expected);
+    bench::report_rate(name, s, count);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t count = bench::size_arg_mib(argc, argv, 1) << 20;
+
+    std::vector<std::byte> wire(count * wire_size_v<Quote>);
+    std::uint32_t state = 12345;
+    auto next = [&] {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    };
+    std::size_t expected = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        PlainQuote q{static_cast<std::uint16_t>(1 + next() % 4096),
+                     static_cast<std::uint16_t>(1 + next() % 1000),
+                     1 + next(), 0.01 * (1 + next() % 100000),
+                     static_cast<std::int64_t>(next()) * 1000};
+        if (next() % 10 == 0) {
+            switch (next() % 5) {
+            case 0: q.venue = 0; break;
+            case 1: q.lots = 1001; break;
+            case 2: q.instrument = 0; break;
+            case 3: q.price = -q.price; break;
+            default: q.micros = -1; break;
+            }
+        } else {
+            ++expected;
+        }
+        std::byte* p = wire.data() + i * wire_size_v<Quote>;
+        store_be(p, q.venue);
+        store_be(p + 2, q.lots);
+        store_be(p + 4, q.instrument);
+        store_be(p + 8, q.price);
+        store_be(p + 16, q.micros);
+    }
+
+    run("decode then validate", wire, expected, decode_then_validate);
+    run("decode<Quote>", wire, expected, [](const std::byte* p) {
+        auto q = decode<Quote, std::endian::big>(
+            std::span(p, wire_size_v<Quote>));
+        return q ? std::optional<Quote>(*q) : std::nullopt;
+    });
+    return 0;
+}
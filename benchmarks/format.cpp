@@ -0,0 +1,83 @@
+// format.cpp — Bounded-width output of interval-refined integers
+//
+// Writes a batch of Refined<std::int32_t, Interval<0, 999>> and PortNumber<>
+// values as decimal text, comparing refinery::to_chars and the Refined
+// std::formatter ("{}") against std::to_chars / std::format_to on the
+// underlying int.
+//
+// Usage: bench_format [count-in-Mi-values]   (default 16)
+
+#include <refinery/charconv.hpp>
+#include <refinery/domain.hpp>
+
+#include <charconv>
+#include <cstdint>
+#include <format>
+#include <vector>
+
+#include "bench.hpp"
+
+using namespace refinery;
+
+namespace {
+
+using Millis = IntervalRefined<std::int32_t, 0, 999>;
+
+// Write every value into one buffer, as a log or serializer would
+template <typename R, typename F>
+void run(std::string_view name, const std::vector<R>& values, F&& write) {
+    std::vector<char> out(values.size() * 12);
+    std::size_t written = 0;
+    double s = bench::best_of(5, [&] {
+        char* p = out.data();
+        for (const R& v : values) {
+            p = write(p, v);
+            *p++ = ' ';
+        }
+        written = static_cast<std::size_t>(p - out.data());
+        bench::do_not_optimize(out.data());
+    });
+    bench::do_not_optimize(written);
+    bench::report_rate(name, s, values.size());
+}
+
+template <typename R>
+void run_all(std::string_view label, const std::vector<R>& values) {
+    std::printf("%.*s\n", static_cast<int>(label.size()), label.data());
+    run("  std::to_chars(int)", values, [](char* p, const R& v) {
+        return std::to_chars(p, p + 12, v.get()).ptr;
+    });
+    run("  refinery::to_chars", values, [](char* p, const R& v) {
+        return to_chars(p, p + 12, v).ptr;
+    });
+    run("  std::format_to(int)", values, [](char* p, const R& v) {
+        return std::format_to(p, "{}", v.get());
+    });
+    run("  std::format_to(Refined)", values, [](char* p, const R& v) {
+        return std::format_to(p, "{}", v);
+    });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t count = bench::size_arg_mib(argc, argv, 16) << 20;
+
+    std::vector<Millis> millis;
+    std::vector<PortNumber<>> ports;
+    millis.reserve(count);
+    ports.reserve(count);
+    std::uint32_t state = 12345;
+    for (std::size_t i = 0; i < count; ++i) {
+        state = state * 1664525u + 1013904223u;
+        millis.push_back(Millis{static_cast<std::int32_t>(state % 1000),
+                                assume_valid});
+        ports.push_back(PortNumber<>{
+            static_cast<std::int32_t>(1 + (state >> 8) % 65535),
+            assume_valid});
+    }
+
+    run_all("Interval<0, 999>", millis);
+    run_all("PortNumber<>", ports);
+    return 0;
+}
@@ -0,0 +1,106 @@
+// mmap.cpp — MappedArray<R> versus read() + per-element try_refine
+//
+// Writes a file of doubles, then loads it as validated prices three ways:
+// read() into a buffer and try_refine each element into a std::vector<R>,
+// MappedArray<R>::open on one thread, and MappedArray<R>::open on a
+// WorkStealingPool of every core. The file is read once beforehand, so
+// all three are served from the page cache and the difference is copying
+// and checking, not disk speed.
+//
+// Usage: bench_mmap [file-size-in-MiB]   (default 512)
+
+#include <refinery/interval.hpp>
+#include <refinery/mmap.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+
+using namespace refinery;
+
+namespace {
+
+using Price = IntervalRefined<double, 0.0, 1e6>;
+
+std::optional<std::vector<Price>> read_and_refine(const char* path,
+                                                  std::size_t bytes) {
+    std::vector<double> buffer(bytes / sizeof(double));
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+        return std::nullopt;
+    auto* p = reinterpret_cast<char*>(buffer.data());
+    for (std::size_t done = 0; done < bytes;) {
+        ssize_t n = ::read(fd, p + done, bytes - done);
+        if (n <= 0) {
+            ::close(fd);
+            return std::nullopt;
+        }
+        done += static_cast<std::size_t>(n);
+    }
+    ::close(fd);
+
+    std::vector<Price> out;
+    out.reserve(buffer.size());
+    for (double v : buffer) {
+        auto p = try_refine<Price>(v);
+        if (!p)
+            return std::nullopt;
+        out.push_back(*p);
+    }
+    return out;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t bytes = bench::size_arg_mib(argc, argv, 512) << 20;
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() /
+        ("refinery_bench_mmap_" + std::to_string(::getpid()));
+
+    {
+        std::vector<double> values(bytes / sizeof(double));
+        std::uint32_t state = 12345;
+        for (double& v : values) {
+            state = state * 1664525u + 1013904223u;
+            v = 0.01 * (state >> 12);
+        }
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(values.data()),
+                  static_cast<std::streamsize>(bytes));
+    }
+    // Warm the page cache
+    bench::do_not_optimize(read_and_refine(path.c_str(), bytes).has_value());
+
+    double s = bench::best_of(3, [&] {
+        auto all = read_and_refine(path.c_str(), bytes);
+        bench::do_not_optimize(all);
+    });
+    bench::report_throughput("read() + try_refine", s, bytes);
+
+    s = bench::best_of(3, [&] {
+        auto mapped = MappedArray<Price>::open(path);
+        bench::do_not_optimize(mapped);
+    });
+    bench::report_throughput("MappedArray, 1 thread", s, bytes);
+
+    WorkStealingPool pool;
+    s = bench::best_of(3, [&] {
+        auto mapped = MappedArray<Price>::open(path, pool);
+        bench::do_not_optimize(mapped);
+    });
+    std::string name =
+        "MappedArray, pool of " + std::to_string(pool.size());
+    bench::report_throughput(name, s, bytes);
+
+    std::filesystem::remove(path);
+    return 0;
+}
@@ -0,0 +1,82 @@
+// parse.cpp — parse_refined<R> versus std::from_chars + try_refine
+//
+// Parses a batch of decimal strings into PortNumber<> (about a quarter of
+// them out of range, some far too long) with the fused parser and with the
+// two-step approach it replaces.
+//
+// Usage: bench_parse [count-in-Mi-strings]   (default 4)
+
+#include <refinery/charconv.hpp>
+#include <refinery/domain.hpp>
+
+#include <charconv>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+
+using namespace refinery;
+
+namespace {
+
+std::optional<PortNumber<>> two_step(std::string_view text) {
+    std::int32_t raw = 0;
+    const char* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, raw);
+    if (ec != std::errc{} || ptr != end)
+        return std::nullopt;
+    return try_refine<PortNumber<>>(raw);
+}
+
+template <typename F>
+void run(std::string_view name, const std::vector<std::string>& inputs,
+         std::size_t expected, F&& fn) {
+    std::size_t sum = 0;
+    double s = bench::best_of(5, [&] {
+        sum = 0;
+        for (const std::string& input : inputs) {
+            if (auto port = fn(input))
+                sum += static_cast<std::size_t>(port->get());
+        }
+        bench::do_not_optimize(sum);
+    });
+    if (sum != expected)
+        std::printf("result mismatch in %.*s\n",
+                    static_cast<int>(name.size()), name.data());
+    bench::report_rate(name, s, inputs.size());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t count = bench::size_arg_mib(argc, argv, 4) << 20;
+
+    std::vector<std::string> inputs;
+    inputs.reserve(count);
+    std::uint32_t state = 12345;
+    for (std::size_t i = 0; i < count; ++i) {
+        state = state * 1664525u + 1013904223u;
+        switch (state >> 30) {
+        case 0: // far too long
+            inputs.push_back(std::to_string(state) + std::to_string(state));
+            break;
+        default:
+            inputs.push_back(std::to_string((state >> 8) % 87000));
+            break;
+        }
+    }
+
+    std::size_t expected = 0;
+    for (const std::string& input : inputs) {
+        if (auto port = two_step(input))
+            expected += static_cast<std::size_t>(port->get());
+    }
+
+    run("from_chars + try_refine", inputs, expected, two_step);
+    run("parse_refined", inputs, expected, [](std::string_view text) {
+        return parse_refined<PortNumber<>>(text);
+    });
+    return 0;
+}
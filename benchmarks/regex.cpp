@@ -0,0 +1,67 @@
+// regex.cpp — Matches<"pattern"> versus std::regex_match
+//
+// Validates a batch of short identifier-like strings (about half of them
+// valid) with the compile-time DFA and with std::regex using the same
+// pattern. std::regex is constructed once, outside the timed loop.
+//
+// Usage: bench_regex [count-in-Mi-strings]   (default 1)
+
+#include <refinery/regex.hpp>
+
+#include <cstdint>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+
+using namespace refinery;
+
+namespace {
+
+constexpr auto Identifier = Matches<"[A-Za-z_][A-Za-z0-9_]{0,31}">;
+
+template <typename F>
+void run(std::string_view name, const std::vector<std::string>& inputs,
+         std::size_t expected, F&& fn) {
+    std::size_t accepted = 0;
+    double s = bench::best_of(3, [&] {
+        accepted = 0;
+        for (const std::string& input : inputs)
+            accepted += fn(input) ? 1 : 0;
+        bench::do_not_optimize(accepted);
+    });
+    if (accepted != expected)
+        std::printf("result mismatch in %.*s: %zu != %zu\n",
+                    static_cast<int>(name.size()), name.data(), accepted,
+                    expected);
+    bench::report_rate(name, s, inputs.size());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t count = bench::size_arg_mib(argc, argv, 1) << 20;
+
+    std::vector<std::string> inputs;
+    inputs.reserve(count);
+    std::uint32_t state = 12345;
+    for (std::size_t i = 0; i < count; ++i) {
+        state = state * 1664525u + 1013904223u;
+        std::string s = "name_" + std::to_string(state % 100000);
+        if (state & 0x10000u)
+            s[state % s.size()] = "-. 9"[(state >> 20) % 4];
+        inputs.push_back(std::move(s));
+    }
+
+    std::size_t expected = 0;
+    for (const std::string& input : inputs)
+        expected += Identifier(input) ? 1 : 0;
+
+    const std::regex re("[A-Za-z_][A-Za-z0-9_]{0,31}");
+    run("std::regex_match", inputs, expected,
+        [&](const std::string& s) { return std::regex_match(s, re); });
+    run("Matches<...>", inputs, expected,
+        [](const std::string& s) { return Identifier(s); });
+    return 0;
+}
@@ -0,0 +1,131 @@
+// ring.cpp — refined ring buffers versus re-validating consumers
+//
+// Throughput: a producer thread streams validated prices to a consumer
+// thread that sums them, once through SpscRing<Price> (the consumer trusts
+// the type) and once through a ring of plain doubles whose consumer
+// re-validates every value with try_refine, in batches of 64.
+// Latency: round trips of one value between two threads over a pair of
+// rings, for SpscRing and MpmcRing. Waiting sides yield, so the numbers stay
+// meaningful when there are fewer cores than threads.
+//
+// Usage: bench_ring [count-in-Mi-values]   (default 16)
+
+#include <refinery/interval.hpp>
+#include <refinery/ring.hpp>
+
+#include <array>
+#include <atomic>
+#include <thread>
+
+#include "bench.hpp"
+
+using namespace refinery;
+
+namespace {
+
+using Price = IntervalRefined<double, 0.0, 1e6>;
+using Plain = Refined<double, Always>;
+constexpr std::size_t batch = 64;
+
+template <typename R, typename Consume>
+void throughput(std::string_view name, std::size_t count, Consume consume) {
+    double sum = 0;
+    double s = bench::best_of(3, [&] {
+        SpscRing<R> ring(RingCapacity{4096});
+        std::jthread producer([&] {
+            std::array<R, batch> values{};
+            for (std::size_t sent = 0; sent < count;) {
+                for (std::size_t i = 0; i < batch; ++i)
+                    values[i] = R(static_cast<double>((sent + i) % 1000),
+                                  assume_valid);
+                std::size_t n = std::min(batch, count - sent);
+                std::size_t pushed = 0;
+                while (pushed < n) {
+                    auto rest = std::span(values).subspan(pushed, n - pushed);
+                    if (std::size_t k = ring.push(rest))
+                        pushed += k;
+                    else
+                        std::this_thread::yield();
+                }
+                sent += n;
+            }
+        });
+        sum = consume(ring, count);
+    });
+    bench::do_not_optimize(sum);
+    bench::report_rate(name, s, count);
+}
+
+template <typename Ring>
+void latency(std::string_view name, std::size_t round_trips) {
+    Ring ping(RingCapacity{64});
+    Ring pong(RingCapacity{64});
+    double s = bench::best_of(3, [&] {
+        std::jthread echo([&] {
+            for (std::size_t i = 0; i < round_trips; ++i) {
+                std::optional<Price> v;
+                while (!(v = ping.try_pop()))
+                    std::this_thread::yield();
+                while (!pong.try_push(*v))
+                    std::this_thread::yield();
+            }
+        });
+        for (std::size_t i = 0; i < round_trips; ++i) {
+            while (!ping.try_push(Price(1.0, assume_valid)))
+                std::this_thread::yield();
+            while (!pong.try_pop())
+                std::this_thread::yield();
+        }
+    });
+    bench::report_rate(name, s, round_trips);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t count = bench::size_arg_mib(argc, argv, 16) << 20;
+
+    std::printf("throughput\n");
+    throughput<Plain>("plain ring + try_refine", count,
+                      [](SpscRing<Plain>& ring, std::size_t n) {
+                          std::vector<Plain> got;
+                          got.reserve(batch);
+                          double sum = 0;
+                          for (std::size_t received = 0; received < n;) {
+                              got.clear();
+                              std::size_t n_got =
+                                  ring.pop(std::back_inserter(got), batch);
+                              if (n_got == 0)
+                                  std::this_thread::yield();
+                              received += n_got;
+                              for (const Plain& v : got) {
+                                  if (auto p = try_refine<Price>(v.get()))
+                                      sum += p->get();
+                              }
+                          }
+                          return sum;
+                      });
+    throughput<Price>("SpscRing<Price>", count,
+                      [](SpscRing<Price>& ring, std::size_t n) {
+                          std::vector<Price> got;
+                          got.reserve(batch);
+                          double sum = 0;
+                          for (std::size_t received = 0; received < n;) {
+                              got.clear();
+                              std::size_t n_got =
+                                  ring.pop(std::back_inserter(got), batch);
+                              if (n_got == 0)
+                                  std::this_thread::yield();
+                              received += n_got;
+                              for (const Price& p : got)
+                                  sum += p.get();
+                          }
+                          return sum;
+                      });
+
+    std::printf("round-trip latency\n");
+    const std::size_t trips = std::max<std::size_t>(count >> 6, 1);
+    latency<SpscRing<Price>>("SpscRing<Price>", trips);
+    latency<MpmcRing<Price>>("MpmcRing<Price>", trips);
+    return 0;
+}
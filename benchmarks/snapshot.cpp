@@ -0,0 +1,83 @@
+// snapshot.cpp — restart cost of reloading refined arrays
+//
+// Writes a snapshot of prices once, then times reopening it under each
+// snapshot_check policy, next to MappedArray<R>::open on the raw values,
+// which has to run the predicate on every element. Everything is served
+// from the page cache.
+//
+// Usage: bench_snapshot [file-size-in-MiB]   (default 512)
+
+#include <refinery/interval.hpp>
+#include <refinery/mmap.hpp>
+#include <refinery/snapshot.hpp>
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+
+using namespace refinery;
+
+namespace {
+
+using Price = IntervalRefined<double, 0.0, 1e6>;
+
+template <typename F>
+void run(std::string_view name, std::size_t bytes, F&& fn) {
+    double s = bench::best_of(5, [&] {
+        auto loaded = fn();
+        if (!loaded)
+            std::printf("load failed\n");
+        bench::do_not_optimize(loaded);
+    });
+    bench::report_throughput(name, s, bytes);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t bytes = bench::size_arg_mib(argc, argv, 512) << 20;
+    const auto dir = std::filesystem::temp_directory_path();
+    const std::string tag = std::to_string(::getpid());
+    const auto raw_path = dir / ("refinery_bench_raw_" + tag);
+    const auto snap_path = dir / ("refinery_bench_snap_" + tag);
+
+    {
+        std::vector<Price> prices;
+        prices.reserve(bytes / sizeof(Price));
+        std::uint32_t state = 12345;
+        for (std::size_t i = 0; i < bytes / sizeof(Price); ++i) {
+            state = state * 1664525u + 1013904223u;
+            prices.push_back(Price(0.01 * (state >> 12), assume_valid));
+        }
+        std::ofstream out(raw_path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(prices.data()),
+                  static_cast<std::streamsize>(bytes));
+        out.close();
+        if (write_snapshot(snap_path, std::span<const Price>(prices))) {
+            std::printf("cannot write snapshot\n");
+            return 1;
+        }
+    }
+
+    run("MappedArray (predicate)", bytes,
+        [&] { return MappedArray<Price>::open(raw_path); });
+    run("Snapshot, full", bytes, [&] {
+        return Snapshot<Price>::open(snap_path, snapshot_check::full);
+    });
+    run("Snapshot, checksum", bytes, [&] {
+        return Snapshot<Price>::open(snap_path, snapshot_check::checksum);
+    });
+    run("Snapshot, header", bytes, [&] {
+        return Snapshot<Price>::open(snap_path, snapshot_check::header);
+    });
+
+    std::filesystem::remove(raw_path);
+    std::filesystem::remove(snap_path);
+    return 0;
+}
@@ -0,0 +1,120 @@
+// soa.cpp — RefinedSoA<Record> versus std::vector<Record>
+//
+// Scans one column (sum of prices) and filters on another (rows with a
+// large quantity) over the same records held as an array of structs and as
+// RefinedSoA columns, where the interval-refined venue is stored in a byte.
+//
+// Usage: bench_soa [count-in-Mi-records]   (default 4)
+
+#include <refinery/refinery.hpp>
+#include <refinery/soa.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "bench.hpp"
+
+using namespace refinery;
+
+namespace {
+
+struct Trade {
+    IntervalRefined<std::int32_t, 1, 200> venue;
+    PositiveI32 quantity;
+    PositiveF64 price;
+    std::int64_t timestamp;
+    NonZeroU64 order_id;
+};
+
+template <typename F>
+void run(std::string_view name, std::size_t rows, double expected, F&& fn) {
+    double result = 0;
+    double s = bench::best_of(5, [&] {
+        result = fn();
+        bench::do_not_optimize(result);
+    });
+    if (result != expected)
+        std::printf("result mismatch in %.*s\n", static_cast<int>(name.size()),
+                    name.data());
+    bench::report_rate(name, s, rows);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t count = bench::size_arg_mib(argc, argv, 4) << 20;
+
+    std::vector<Trade> aos;
+    RefinedSoA<Trade> soa;
+    aos.reserve(count);
+    soa.reserve(count);
+    std::uint32_t state = 12345;
+    auto next = [&] {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    };
+    for (std::size_t i = 0; i < count; ++i) {
+        Trade t{
+            IntervalRefined<std::int32_t, 1, 200>(1 + next() % 200,
+                                                  assume_valid),
+            PositiveI32(static_cast<std::int32_t>(1 + next() % 1000),
+                        assume_valid),
+            PositiveF64(0.25 * (1 + next() % 4000), assume_valid),
+            static_cast<std::int64_t>(i), NonZeroU64(i + 1, assume_valid)};
+        aos.push_back(t);
+        soa.push_back(t);
+    }
+
+    double sum = 0;
+    std::size_t big = 0;
+    for (const Trade& t : aos) {
+        sum += t.price.get();
+        big += t.quantity.get() > 900 ? 1 : 0;
+    }
+
+    std::printf("scan: sum of price\n");
+    run("std::vector<Trade>", count, sum, [&] {
+        double total = 0;
+        for (const Trade& t : aos)
+            total += t.price.get();
+        return total;
+    });
+    run("RefinedSoA<Trade>", count, sum, [&] {
+        double total = 0;
+        for (double p : soa.storage<&Trade::price>())
+            total += p;
+        return total;
+    });
+
+    std::printf("filter: quantity > 900\n");
+    const double expected = static_cast<double>(big);
+    run("std::vector<Trade>", count, expected, [&] {
+        std::vector<std::size_t> rows;
+        for (std::size_t i = 0; i < aos.size(); ++i) {
+            if (aos[i].quantity.get() > 900)
+                rows.push_back(i);
+        }
+        return static_cast<double>(rows.size());
+    });
+    run("RefinedSoA<Trade>", count, expected, [&] {
+        auto rows = soa.filter<&Trade::quantity>(
+            [](std::int32_t q) { return q > 900; });
+        return static_cast<double>(rows.size());
+    });
+
+    std::printf("count: venue == 7\n");
+    std::size_t venue7 = 0;
+    for (const Trade& t : aos)
+        venue7 += t.venue.get() == 7 ? 1 : 0;
+    run("std::vector<Trade>", count, static_cast<double>(venue7), [&] {
+        std::size_t n = 0;
+        for (const Trade& t : aos)
+            n += t.venue.get() == 7 ? 1 : 0;
+        return static_cast<double>(n);
+    });
+    run("RefinedSoA<Trade>", count, static_cast<double>(venue7), [&] {
+        return static_cast<double>(soa.count_if<&Trade::venue>(
+            [](std::int32_t v) { return v == 7; }));
+    });
+    return 0;
+}
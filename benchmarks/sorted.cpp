@@ -0,0 +1,116 @@
+// sorted.cpp — std algorithms versus algorithms on sorted refinements
+//
+// Searches a strictly sorted array of random 32-bit keys with
+// std::ranges::lower_bound and with the branchless refined_lower_bound,
+// then intersects and unites it with a second sorted array of equal size
+// and with one 1024 times smaller, using std::ranges::set_intersection /
+// set_union and the galloping refined_set_* versions. Also times the
+// Sorted check itself against std::ranges::is_sorted.
+//
+// Usage: bench_sorted [elements-in-Mi]   (default 4)
+
+#include <refinery/refinery.hpp>
+#include <refinery/sorted.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+
+using namespace refinery;
+
+namespace {
+
+using Keys = Refined<std::vector<std::uint32_t>, StrictlySorted>;
+
+Keys random_keys(std::mt19937& rng, std::size_t n) {
+    std::vector<std::uint32_t> keys(n);
+    for (auto& k : keys)
+        k = static_cast<std::uint32_t>(rng());
+    return refined_sort_unique(std::move(keys));
+}
+
+template <typename SetOp, typename RefinedOp>
+void compare_set_op(const char* std_name, const char* refined_name,
+                    const Keys& a, const Keys& b, SetOp std_op,
+                    RefinedOp refined_op) {
+    const std::size_t items = a->size() + b->size();
+    double std_s = bench::best_of(5, [&] {
+        std::vector<std::uint32_t> out;
+        std_op(*a, *b, std::back_inserter(out));
+        bench::do_not_optimize(out.data());
+    });
+    double refined_s = bench::best_of(5, [&] {
+        auto out = refined_op(a, b);
+        bench::do_not_optimize(out->data());
+    });
+    bench::report_rate(std_name, std_s, items);
+    bench::report_rate(refined_name, refined_s, items);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t n = bench::size_arg_mib(argc, argv, 4) << 20;
+    std::mt19937 rng(42);
+    const Keys keys = random_keys(rng, n);
+    const Keys peer = random_keys(rng, n);
+    const Keys few = random_keys(rng, n / 1024);
+
+    // Half of the queries are present, half are random
+    std::vector<std::uint32_t> queries(1 << 20);
+    for (std::size_t i = 0; i < queries.size(); ++i)
+        queries[i] = i % 2 ? static_cast<std::uint32_t>(rng())
+                           : keys.get()[rng() % keys->size()];
+
+    double std_s = bench::best_of(5, [&] {
+        std::size_t found = 0;
+        for (std::uint32_t q : queries)
+            found += std::ranges::binary_search(*keys, q);
+        bench::do_not_optimize(found);
+    });
+    double refined_s = bench::best_of(5, [&] {
+        std::size_t found = 0;
+        for (std::uint32_t q : queries)
+            found += refined_contains(keys, q);
+        bench::do_not_optimize(found);
+    });
+    bench::report_rate("std::ranges::binary_search", std_s, queries.size());
+    bench::report_rate("refined_contains (branchless)", refined_s,
+                       queries.size());
+
+    compare_set_op(
+        "std::ranges::set_intersection n:n", "refined_set_intersection n:n",
+        keys, peer, std::ranges::set_intersection,
+        [](const Keys& a, const Keys& b) {
+            return refined_set_intersection(a, b);
+        });
+    compare_set_op(
+        "std::ranges::set_intersection n:n/1024",
+        "refined_set_intersection n:n/1024", keys, few,
+        std::ranges::set_intersection, [](const Keys& a, const Keys& b) {
+            return refined_set_intersection(a, b);
+        });
+    compare_set_op(
+        "std::ranges::set_union n:n/1024", "refined_set_union n:n/1024", keys,
+        few, std::ranges::set_union,
+        [](const Keys& a, const Keys& b) { return refined_set_union(a, b); });
+
+    std::vector<std::uint32_t> raw = keys.get();
+    double is_sorted_s = bench::best_of(5, [&] {
+        bench::do_not_optimize(std::ranges::is_sorted(raw));
+    });
+    double check_s = bench::best_of(5, [&] {
+        bench::do_not_optimize(StrictlySorted(raw));
+    });
+    bench::report_throughput("std::ranges::is_sorted", is_sorted_s,
+                             raw.size() * sizeof(std::uint32_t));
+    bench::report_throughput("StrictlySorted check", check_s,
+                             raw.size() * sizeof(std::uint32_t));
+    return 0;
+}
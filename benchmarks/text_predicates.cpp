@@ -0,0 +1,82 @@
+// text_predicates.cpp — Throughput of the text.hpp string predicates
+//
+// Compares Ascii / NoNul / ValidUtf8 / CharsIn against the byte-by-byte
+// loops they replace, on a buffer that satisfies every predicate (the
+// worst case: no early exit).
+//
+// Usage: bench_text_predicates [size-in-MiB]   (default 64)
+
+#include <refinery/text.hpp>
+
+#include <string>
+
+#include "bench.hpp"
+
+using namespace refinery;
+
+namespace {
+
+bool bytewise_ascii(std::string_view s) {
+    for (char c : s) {
+        if (static_cast<unsigned char>(c) >= 0x80)
+            return false;
+    }
+    return true;
+}
+
+bool bytewise_no_nul(std::string_view s) {
+    for (char c : s) {
+        if (c == '\0')
+            return false;
+    }
+    return true;
+}
+
+bool bytewise_hex(std::string_view s) {
+    for (char c : s) {
+        bool ok = (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') ||
+                  (c >= 'A' && c <= 'F');
+        if (!ok)
+            return false;
+    }
+    return true;
+}
+
+template <typename F>
+void run(std::string_view name, const std::string& input, F&& fn) {
+    bool result = false;
+    double s = bench::best_of(5, [&] {
+        result = fn(std::string_view{input});
+        bench::do_not_optimize(result);
+    });
+    if (!result)
+        std::printf("unexpected failure in %.*s\n",
+                    static_cast<int>(name.size()), name.data());
+    bench::report_throughput(name, s, input.size());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t bytes = bench::size_arg_mib(argc, argv, 64) << 20;
+
+    std::string ascii(bytes, 'a');
+    std::string hex(bytes, '0');
+    std::string utf8;
+    utf8.reserve(bytes);
+    for (std::size_t i = 0; i < bytes; ++i)
+        hex[i] = "0123456789abcdefABCDEF"[i % 22];
+    while (utf8.size() + 16 <= bytes)
+        utf8 += "caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80 ok"; // 16 bytes
+    utf8.resize(bytes, 'x');
+
+    run("bytewise ascii", ascii, bytewise_ascii);
+    run("Ascii", ascii, Ascii);
+    run("bytewise no-nul", ascii, bytewise_no_nul);
+    run("NoNul", ascii, NoNul);
+    run("ValidUtf8 (ascii input)", ascii, ValidUtf8);
+    run("ValidUtf8 (mixed input)", utf8, ValidUtf8);
+    run("bytewise hex digits", hex, bytewise_hex);
+    run("CharsIn<IsHexDigit>", hex, CharsIn<IsHexDigit>);
+    return 0;
+}
@@ -0,0 +1,156 @@
+// wire.cpp — trusted versus validating receivers over a socketpair
+//
+// A sender thread streams frames of 4096 quote records (24 bytes each on
+// the wire) through a Unix-domain socketpair; the receiver reassembles
+// frames and decodes them with decode_frame, once re-validating every
+// member (wire_trust::validate) and once trusting the peer
+// (wire_trust::trusted). The same decodes are also timed from memory,
+// without the socket, to separate the decode cost from the transfer.
+//
+// Usage: bench_wire [count-in-Mi-records]   (default 4)
+
+#include <refinery/refinery.hpp>
+#include <refinery/wire.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "bench.hpp"
+
+using namespace refinery;
+
+namespace {
+
+struct Quote {
+    IntervalRefined<std::uint16_t, 1, 4096> venue;
+    IntervalRefined<std::uint16_t, 1, 1000> lots;
+    NonZeroU32 instrument;
+    PositiveF64 price;
+    [[= check<Interval<0, 86'400'000'000>{}>]] std::int64_t micros;
+};
+
+constexpr std::size_t records_per_frame = 4096;
+
+std::vector<std::byte> make_frame() {
+    std::vector<Quote> quotes;
+    std::uint32_t state = 12345;
+    auto next = [&] {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    };
+    for (std::size_t i = 0; i < records_per_frame; ++i) {
+        quotes.push_back(Quote{
+            decltype(Quote::venue)(
+                static_cast<std::uint16_t>(1 + next() % 4096), assume_valid),
+            decltype(Quote::lots)(
+                static_cast<std::uint16_t>(1 + next() % 1000), assume_valid),
+            NonZeroU32(1 + next(), assume_valid),
+            PositiveF64(0.01 * (1 + next() % 100000), assume_valid),
+            static_cast<std::int64_t>(next()) * 1000});
+    }
+    std::vector<std::byte> frame;
+    encode_frame<Quote>(quotes, frame);
+    return frame;
+}
+
+// Receive `frames` frames from fd and decode them; returns records decoded
+std::size_t receive(int fd, std::size_t frames, wire_trust trust,
+                    std::vector<Quote>& out) {
+    std::vector<std::byte> buffer(1 << 20);
+    std::size_t have = 0;
+    std::size_t decoded = 0;
+    while (frames > 0) {
+        ssize_t n = ::read(fd, buffer.data() + have, buffer.size() - have);
+        if (n <= 0)
+            break;
+        have += static_cast<std::size_t>(n);
+        std::size_t used = 0;
+        while (frames > 0) {
+            std::span<const std::byte> rest(buffer.data() + used, have - used);
+            auto size = frame_size(rest);
+            if (!size || *size > rest.size())
+                break;
+            out.clear();
+            if (!decode_frame<Quote>(rest, trust, out))
+                return decoded;
+            decoded += out.size();
+            used += *size;
+            --frames;
+        }
+        std::memmove(buffer.data(), buffer.data() + used, have - used);
+        have -= used;
+    }
+    return decoded;
+}
+
+void over_socket(std::string_view name, const std::vector<std::byte>& frame,
+                 std::size_t frames, wire_trust trust) {
+    std::size_t decoded = 0;
+    double s = bench::best_of(3, [&] {
+        int fds[2];
+        if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+            return;
+        std::jthread sender([&] {
+            for (std::size_t i = 0; i < frames; ++i) {
+                const std::byte* p = frame.data();
+                std::size_t left = frame.size();
+                while (left > 0) {
+                    ssize_t n = ::write(fds[0], p, left);
+                    if (n <= 0)
+                        return;
+                    p += n;
+                    left -= static_cast<std::size_t>(n);
+                }
+            }
+        });
+        std::vector<Quote> out;
+        out.reserve(records_per_frame);
+        decoded = receive(fds[1], frames, trust, out);
+        sender.join();
+        ::close(fds[0]);
+        ::close(fds[1]);
+    });
+    if (decoded != frames * records_per_frame)
+        std::printf("decoded %zu records in %.*s\n", decoded,
+                    static_cast<int>(name.size()), name.data());
+    bench::report_rate(name, s, frames * records_per_frame);
+}
+
+void in_memory(std::string_view name, const std::vector<std::byte>& frame,
+               std::size_t frames, wire_trust trust) {
+    std::vector<Quote> out;
+    out.reserve(records_per_frame);
+    double s = bench::best_of(3, [&] {
+        for (std::size_t i = 0; i < frames; ++i) {
+            out.clear();
+            bench::do_not_optimize(
+                decode_frame<Quote>(frame, trust, out).has_value());
+        }
+    });
+    bench::report_rate(name, s, frames * records_per_frame);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t count = bench::size_arg_mib(argc, argv, 4) << 20;
+    const std::size_t frames = count / records_per_frame;
+    const auto frame = make_frame();
+
+    std::printf("socketpair\n");
+    over_socket("validate", frame, frames, wire_trust::validate);
+    over_socket("trusted", frame, frames, wire_trust::trusted);
+    std::printf("decode only\n");
+    in_memory("validate", frame, frames, wire_trust::validate);
+    in_memory("trusted", frame, frames, wire_trust::trusted);
+    return 0;
+}
@@ -0,0 +1,68 @@
+// 10_chunked_loop.cpp — Proves for_each_chunk loops carry no remainder loop
+//
+// A ChunkedSpan<T, 8> is known to hold a whole number of 8-element chunks,
+// so for_each_chunk<8> compiles to one vector loop over the chunks with no
+// scalar tail, the same code as a hand-written chunk loop over a buffer the
+// caller promises is a multiple of 8 long.
+
+#include <cstddef>
+#include <cstdint>
+#include <refinery/refinery.hpp>
+#include <refinery/span.hpp>
+#include <span>
+
+using namespace refinery;
+
+__attribute__((noinline)) void refined_scale(ChunkedSpan<float, 8> s,
+                                             float k) {
+    for_each_chunk<8>(s, [k](std::span<float, 8> chunk) {
+        for (float& x : chunk)
+            x *= k;
+    });
+}
+
+// n must be a multiple of 8
+__attribute__((noinline)) void plain_scale(float* data, std::size_t n,
+                                           float k) {
+    for (std::size_t c = 0; c < n / 8; ++c) {
+        float* chunk = data + c * 8;
+        for (std::size_t j = 0; j < 8; ++j)
+            chunk[j] *= k;
+    }
+}
+
+__attribute__((noinline)) std::uint32_t
+refined_sum(ChunkedSpan<const std::uint32_t, 8> s) {
+    std::uint32_t total = 0;
+    for_each_chunk<8>(s, [&total](std::span<const std::uint32_t, 8> chunk) {
+        for (std::uint32_t x : chunk)
+            total += x;
+    });
+    return total;
+}
+
+// n must be a multiple of 8
+__attribute__((noinline)) std::uint32_t plain_sum(const std::uint32_t* data,
+                                                  std::size_t n) {
+    std::uint32_t total = 0;
+    for (std::size_t c = 0; c < n / 8; ++c) {
+        const std::uint32_t* chunk = data + c * 8;
+        for (std::size_t j = 0; j < 8; ++j)
+            total += chunk[j];
+    }
+    return total;
+}
+
+int main() {
+    static float samples[64] = {};
+    static std::uint32_t counts[64] = {};
+    refined_scale(ChunkedSpan<float, 8>(std::span<float>(samples),
+                                        assume_valid),
+                  0.5f);
+    plain_scale(samples, 64, 0.5f);
+    volatile std::uint32_t sink;
+    sink = refined_sum(ChunkedSpan<const std::uint32_t, 8>(
+        std::span<const std::uint32_t>(counts), assume_valid));
+    sink = plain_sum(counts, 64);
+    return 0;
+}
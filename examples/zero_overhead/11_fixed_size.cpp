@@ -0,0 +1,68 @@
+// 11_fixed_size.cpp — Proves FixedSize<N> kernels are fully unrolled
+//
+// A span refined with FixedSize<16> converts to std::span<T, 16> with no
+// check and no copy, so a 4x4 matrix-vector product and a 16-byte key
+// comparison compile to straight line code: no loop and no test of the
+// run-time size. The plain versions match only by ignoring the size they
+// are passed.
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <refinery/refinery.hpp>
+#include <refinery/span.hpp>
+#include <span>
+
+using namespace refinery;
+
+using Matrix = Refined<std::span<const float>, FixedSize<16>>;
+using Key = Refined<std::span<const unsigned char>, FixedSize<16>>;
+using Vec4 = std::array<float, 4>;
+
+__attribute__((noinline)) void refined_apply(Matrix m, const Vec4& v,
+                                             Vec4& out) {
+    std::span<const float, 16> a = fixed_span(m);
+    for (std::size_t r = 0; r < 4; ++r)
+        out[r] = a[r * 4] * v[0] + a[r * 4 + 1] * v[1] +
+                 a[r * 4 + 2] * v[2] + a[r * 4 + 3] * v[3];
+}
+
+// n must be 16
+__attribute__((noinline)) void plain_apply(const float* m, std::size_t n,
+                                           const Vec4& v, Vec4& out) {
+    (void)n;
+    for (std::size_t r = 0; r < 4; ++r)
+        out[r] = m[r * 4] * v[0] + m[r * 4 + 1] * v[1] +
+                 m[r * 4 + 2] * v[2] + m[r * 4 + 3] * v[3];
+}
+
+__attribute__((noinline)) bool refined_key_equal(Key a, Key b) {
+    return std::memcmp(fixed_span(a).data(), fixed_span(b).data(),
+                       fixed_span(a).size()) == 0;
+}
+
+// na and nb must be 16
+__attribute__((noinline)) bool plain_key_equal(const unsigned char* a,
+                                               std::size_t na,
+                                               const unsigned char* b,
+                                               std::size_t nb) {
+    (void)na;
+    (void)nb;
+    return std::memcmp(a, b, 16) == 0;
+}
+
+int main() {
+    static float m[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+    static unsigned char k1[16] = {}, k2[16] = {};
+    Vec4 v{1, 2, 3, 4};
+    Vec4 out{};
+    refined_apply(Matrix(std::span<const float>(m), assume_valid), v, out);
+    plain_apply(m, 16, v, out);
+    volatile bool sink;
+    sink = refined_key_equal(Key(std::span<const unsigned char>(k1),
+                                 assume_valid),
+                             Key(std::span<const unsigned char>(k2),
+                                 assume_valid));
+    sink = plain_key_equal(k1, 16, k2, 16);
+    return 0;
+}
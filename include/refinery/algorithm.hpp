@@ -0,0 +1,166 @@
+// algorithm.hpp - Algorithms over ranges known to be non-empty
+// Part of the C++26 Refinement Types Library
+//
+// front(), back(), max_element, a reduce without an identity and the mean
+// all have to handle the empty range, even when the caller holds
+// Refined<C, NonEmpty> and the case cannot happen. These versions take the
+// refined range and start from its first element unconditionally, so they
+// compile without an emptiness branch:
+//
+//   Refined<std::vector<PositiveI32>, NonEmpty> latencies = ...;
+//   PositiveI32 worst = refined_max(latencies);      // no optional, no check
+//   auto total = refined_fold1(latencies, std::plus<>{});
+//   auto mean = refined_mean(latencies);   // Refined<double, Interval<1, max>>
+//
+// Results keep the elements' refinement: the max or min of PositiveI32
+// values is a PositiveI32, and the mean of values in Interval<Lo, Hi> is a
+// double in the same interval. refined_fold1 returns whatever the operation
+// returns, so refined arithmetic carries its own result predicates.
+//
+// Besides NonEmpty itself (and predicates declared to imply it through
+// traits::implies), a range qualifies when its predicate is a size bound
+// that excludes zero: SizeAtLeast(n), SizeExactly(n) and SizeInRange(n, m)
+// with n > 0, or FixedSize<N> with N > 0.
+
+#ifndef REFINERY_ALGORITHM_HPP
+#define REFINERY_ALGORITHM_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "predicates.hpp"
+#include "refined_type.hpp"
+
+namespace refinery {
+
+namespace detail {
+
+template <typename C, auto Pred> consteval bool excludes_empty() {
+    if constexpr (predicate_implies<C, Pred, NonEmpty>())
+        return true;
+    else if constexpr (has_exact_size<Pred>)
+        return decltype(Pred)::exact > 0;
+    else if constexpr (size_interval_predicate<Pred>)
+        return !Pred(sized{0});
+    else
+        return false;
+}
+
+// The value inside a refined element, or the element itself
+template <typename E> constexpr const auto& raw_value(const E& e) noexcept {
+    if constexpr (is_refined<E>)
+        return e.get();
+    else
+        return e;
+}
+
+template <typename E> struct raw_type {
+    using type = E;
+};
+
+template <typename E>
+    requires is_refined<E>
+struct raw_type<E> {
+    using type = typename E::value_type;
+};
+
+// An element value known to satisfy E's predicate, as an E
+template <typename E, typename T> constexpr E rewrap(T value) noexcept {
+    if constexpr (is_refined<E>)
+        return E(std::move(value), assume_valid);
+    else
+        return value;
+}
+
+} // namespace detail
+
+// Ranges whose refinement rules out the empty range
+template <typename R>
+concept non_empty_range =
+    is_refined<R> && std::ranges::forward_range<typename R::value_type> &&
+    detail::excludes_empty<typename R::value_type, R::predicate>();
+
+template <non_empty_range R>
+[[nodiscard]] constexpr decltype(auto) refined_front(const R& r) noexcept {
+    return *std::ranges::begin(r.get());
+}
+
+template <non_empty_range R>
+    requires std::ranges::bidirectional_range<typename R::value_type> &&
+             std::ranges::common_range<typename R::value_type>
+[[nodiscard]] constexpr decltype(auto) refined_back(const R& r) noexcept {
+    return *std::ranges::prev(std::ranges::end(r.get()));
+}
+
+// Largest element (the first of equal ones), as the element type
+template <non_empty_range R>
+[[nodiscard]] constexpr auto refined_max(const R& r) {
+    using E = std::ranges::range_value_t<typename R::value_type>;
+    auto it = std::ranges::begin(r.get());
+    const auto last = std::ranges::end(r.get());
+    typename detail::raw_type<E>::type best = detail::raw_value(*it);
+    for (++it; it != last; ++it)
+        best = std::max(best, detail::raw_value(*it));
+    return detail::rewrap<E>(std::move(best));
+}
+
+// Smallest element (the first of equal ones), as the element type
+template <non_empty_range R>
+[[nodiscard]] constexpr auto refined_min(const R& r) {
+    using E = std::ranges::range_value_t<typename R::value_type>;
+    auto it = std::ranges::begin(r.get());
+    const auto last = std::ranges::end(r.get());
+    typename detail::raw_type<E>::type best = detail::raw_value(*it);
+    for (++it; it != last; ++it)
+        best = std::min(best, detail::raw_value(*it));
+    return detail::rewrap<E>(std::move(best));
+}
+
+// Left fold seeded with the first element: op(op(e0, e1), e2) ...
+template <non_empty_range R, typename Op>
+[[nodiscard]] constexpr auto refined_fold1(const R& r, Op op) {
+    using E = std::ranges::range_value_t<typename R::value_type>;
+    using U = std::decay_t<std::invoke_result_t<Op&, E, const E&>>;
+    auto it = std::ranges::begin(r.get());
+    const auto last = std::ranges::end(r.get());
+    U acc = *it;
+    for (++it; it != last; ++it)
+        acc = std::invoke(op, std::move(acc), *it);
+    return acc;
+}
+
+// Arithmetic mean as double. For elements refined with an interval
+// predicate the result is refined with the same interval; rounding is
+// clamped back into it.
+template <non_empty_range R>
+    requires std::ranges::sized_range<typename R::value_type>
+[[nodiscard]] constexpr auto refined_mean(const R& r) {
+    using E = std::ranges::range_value_t<typename R::value_type>;
+    double sum = 0;
+    for (const auto& e : r.get())
+        sum += static_cast<double>(detail::raw_value(e));
+    const double mean = sum / static_cast<double>(std::ranges::size(r.get()));
+    if constexpr (is_refined<E>) {
+        constexpr auto pred = E::predicate;
+        if constexpr (detail::has_interval_bounds<pred>) {
+            return Refined<double, pred>(
+                std::clamp(mean, static_cast<double>(pred.lo),
+                           static_cast<double>(pred.hi)),
+                assume_valid);
+        } else {
+            return mean;
+        }
+    } else {
+        return mean;
+    }
+}
+
+} // namespace refinery
+
+#endif // REFINERY_ALGORITHM_HPP
@@ -0,0 +1,145 @@
+// aligned.hpp - Alignment refinements for pointers and spans
+// Part of the C++26 Refinement Types Library
+//
+// Aligned<N> holds for pointers (and spans whose data pointer is) aligned
+// to N bytes. A function that takes a refined buffer states its alignment
+// in its signature, and aligned_data passes it on to the compiler through
+// std::assume_aligned, so loops over the buffer use aligned vector loads
+// without a scalar prologue to reach an aligned address:
+//
+//   void scale(AlignedPtr<float, 64> data, std::size_t n, float k) {
+//       float* p = aligned_data(data);      // std::assume_aligned<64>
+//       for (std::size_t i = 0; i < n; ++i)
+//           p[i] *= k;
+//   }
+//
+//   alignas(64) float samples[1024];
+//   scale(AlignedPtr<float, 64>(samples, runtime_check), 1024, 0.5f);
+//
+// AlignedPtr<T, N> is Refined<T*, All<NotNull, Aligned<N>>>;
+// AlignedSpan<T, N> is Refined<std::span<T>, Aligned<N>>. A value aligned
+// to N converts implicitly to one aligned to any smaller M, and an
+// AlignedPtr<T, N> to a Refined<T*, NotNull>.
+//
+// Alignment is a property of an address, so Aligned<N> cannot be checked
+// in a constant expression; build refined pointers with runtime_check, or
+// with assume_valid where the allocation guarantees it.
+
+#ifndef REFINERY_ALIGNED_HPP
+#define REFINERY_ALIGNED_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+
+#include "compose.hpp"
+#include "predicates.hpp"
+#include "refined_type.hpp"
+
+namespace refinery {
+
+namespace detail {
+
+template <std::size_t N> struct aligned_to {
+    static_assert(std::has_single_bit(N), "alignment must be a power of two");
+    static constexpr std::size_t alignment = N;
+
+    template <typename T> bool operator()(T* p) const noexcept {
+        return reinterpret_cast<std::uintptr_t>(p) % N == 0;
+    }
+
+    template <typename T, std::size_t Extent>
+    bool operator()(std::span<T, Extent> s) const noexcept {
+        return (*this)(s.data());
+    }
+};
+
+} // namespace detail
+
+// True if the pointer (or the span's data pointer) is aligned to N bytes
+template <std::size_t N> inline constexpr detail::aligned_to<N> Aligned{};
+
+template <typename T, std::size_t N>
+using AlignedPtr = Refined<T*, All<NotNull, Aligned<N>>>;
+
+template <typename T, std::size_t N>
+using AlignedSpan = Refined<std::span<T>, Aligned<N>>;
+
+namespace detail {
+
+// N if Pred is All<NotNull, Aligned<N>> for some N up to 4096, else 1
+template <auto Pred, std::size_t... Log2>
+consteval std::size_t conjunction_alignment(std::index_sequence<Log2...>) {
+    std::size_t alignment = 1;
+    ((same_predicate_value<Pred, All<NotNull, Aligned<(std::size_t{1}
+                                                       << Log2)>>>::value
+          ? (alignment = std::size_t{1} << Log2)
+          : 0),
+     ...);
+    return alignment;
+}
+
+template <auto Pred>
+inline constexpr std::size_t conjunction_alignment_v =
+    conjunction_alignment<Pred>(std::make_index_sequence<13>{});
+
+template <auto Pred> consteval std::size_t alignment_of() {
+    if constexpr (has_alignment<Pred>)
+        return decltype(Pred)::alignment;
+    else
+        return conjunction_alignment_v<Pred>;
+}
+
+} // namespace detail
+
+// Alignment guaranteed by a predicate: N for Aligned<N> and
+// All<NotNull, Aligned<N>>, 1 for anything else
+template <auto Pred>
+inline constexpr std::size_t alignment_of_v = detail::alignment_of<Pred>();
+
+// predicate_implies compares Aligned<N> with Aligned<M> directly, but
+// cannot see inside the All<NotNull, Aligned<N>> of AlignedPtr: it implies
+// NotNull, and Aligned<M> or All<NotNull, Aligned<M>> for any M <= N
+namespace traits {
+
+template <auto Source, auto Target>
+    requires(detail::conjunction_alignment_v<Source> > 1)
+struct implies<Source, Target> {
+    static constexpr bool value =
+        detail::same_predicate_value<Target, NotNull>::value ||
+        ((detail::has_alignment<Target> ||
+          detail::conjunction_alignment_v<Target> > 1) &&
+         alignment_of_v<Source> >= alignment_of_v<Target>);
+};
+
+} // namespace traits
+
+// The pointer, marked with std::assume_aligned for its guaranteed alignment
+template <typename T, auto Pred>
+    requires(alignment_of_v<Pred> > 1)
+[[nodiscard]] constexpr T* aligned_data(const Refined<T*, Pred>& p) noexcept {
+    return std::assume_aligned<alignment_of_v<Pred>>(p.get());
+}
+
+template <typename T, std::size_t Extent, auto Pred>
+    requires(alignment_of_v<Pred> > 1)
+[[nodiscard]] constexpr T*
+aligned_data(const Refined<std::span<T, Extent>, Pred>& s) noexcept {
+    return std::assume_aligned<alignment_of_v<Pred>>(s->data());
+}
+
+// The span rebuilt over aligned_data(s), so element access through it
+// carries the alignment too
+template <typename T, std::size_t Extent, auto Pred>
+    requires(alignment_of_v<Pred> > 1)
+[[nodiscard]] constexpr std::span<T, Extent>
+aligned_span(const Refined<std::span<T, Extent>, Pred>& s) noexcept {
+    return std::span<T, Extent>(aligned_data(s), s->size());
+}
+
+} // namespace refinery
+
+#endif // REFINERY_ALIGNED_HPP
@@ -0,0 +1,189 @@
+// atomic.hpp - Atomic refined values with predicate-preserving updates
+// Part of the C++26 Refinement Types Library
+//
+// AtomicRefined<T, Pred> holds a T that always satisfies Pred. Loads and
+// stores exchange Refined<T, Pred> values, and read-modify-write operations
+// are compare-and-swap loops that commit only when the new value satisfies
+// Pred, returning std::nullopt otherwise:
+//
+//   using Slots = IntervalRefined<int, 0, 100>;
+//   AtomicRefined<int, Slots::predicate> in_flight{Slots{0}};
+//   if (auto before = in_flight.fetch_add(1)) {
+//       // admitted; *before was the count beforehand
+//   }
+//
+// Integer updates that would overflow T fail the same way instead of
+// wrapping. For trivially copyable T no wider than a machine word the
+// operations are lock-free (is_always_lock_free reports it).
+
+#ifndef REFINERY_ATOMIC_HPP
+#define REFINERY_ATOMIC_HPP
+
+#include <atomic>
+#include <concepts>
+#include <optional>
+#include <type_traits>
+
+#include "refined_type.hpp"
+
+namespace refinery {
+
+namespace detail {
+
+// Memory order for the load that starts a CAS loop under `order`
+constexpr std::memory_order load_order(std::memory_order order) noexcept {
+    if (order == std::memory_order::release)
+        return std::memory_order::relaxed;
+    if (order == std::memory_order::acq_rel)
+        return std::memory_order::acquire;
+    return order;
+}
+
+// a + b, or nullopt if it overflows T
+template <typename T>
+constexpr std::optional<T> add_no_overflow(T a, T b) noexcept {
+    if constexpr (std::integral<T>) {
+        T sum;
+        if (__builtin_add_overflow(a, b, &sum))
+            return std::nullopt;
+        return sum;
+    } else {
+        return a + b;
+    }
+}
+
+// a - b, or nullopt if it overflows T
+template <typename T>
+constexpr std::optional<T> sub_no_overflow(T a, T b) noexcept {
+    if constexpr (std::integral<T>) {
+        T difference;
+        if (__builtin_sub_overflow(a, b, &difference))
+            return std::nullopt;
+        return difference;
+    } else {
+        return a - b;
+    }
+}
+
+} // namespace detail
+
+template <typename T, auto Pred>
+    requires std::is_trivially_copyable_v<T> && predicate_for<decltype(Pred), T>
+class AtomicRefined {
+    std::atomic<T> value_;
+
+  public:
+    using value_type = Refined<T, Pred>;
+
+    static constexpr bool is_always_lock_free =
+        std::atomic<T>::is_always_lock_free;
+
+    constexpr explicit AtomicRefined(value_type initial) noexcept
+        : value_(initial.get()) {}
+
+    AtomicRefined(const AtomicRefined&) = delete;
+    AtomicRefined& operator=(const AtomicRefined&) = delete;
+
+    [[nodiscard]] bool is_lock_free() const noexcept {
+        return value_.is_lock_free();
+    }
+
+    [[nodiscard]] value_type
+    load(std::memory_order order = std::memory_order::seq_cst) const noexcept {
+        return value_type(value_.load(order), assume_valid);
+    }
+
+    void store(value_type desired,
+               std::memory_order order = std::memory_order::seq_cst) noexcept {
+        value_.store(desired.get(), order);
+    }
+
+    value_type
+    exchange(value_type desired,
+             std::memory_order order = std::memory_order::seq_cst) noexcept {
+        return value_type(value_.exchange(desired.get(), order), assume_valid);
+    }
+
+    // On failure, expected receives the current value
+    bool compare_exchange_weak(
+        value_type& expected, value_type desired,
+        std::memory_order order = std::memory_order::seq_cst) noexcept {
+        T current = expected.get();
+        bool ok = value_.compare_exchange_weak(current, desired.get(), order);
+        expected = value_type(current, assume_valid);
+        return ok;
+    }
+
+    bool compare_exchange_strong(
+        value_type& expected, value_type desired,
+        std::memory_order order = std::memory_order::seq_cst) noexcept {
+        T current = expected.get();
+        bool ok = value_.compare_exchange_strong(current, desired.get(), order);
+        expected = value_type(current, assume_valid);
+        return ok;
+    }
+
+    // Replace the value v with f(v) if that satisfies Pred. Returns the
+    // previous value, or nullopt (leaving the value unchanged) if f(v) fails
+    // Pred or f returns nullopt. f may run several times under contention.
+    template <typename F>
+        requires std::convertible_to<std::invoke_result_t<F&, const T&>,
+                                     std::optional<T>>
+    std::optional<value_type>
+    fetch_update(F f,
+                 std::memory_order order = std::memory_order::seq_cst) noexcept(
+        std::is_nothrow_invocable_v<F&, const T&>) {
+        T current = value_.load(detail::load_order(order));
+        for (;;) {
+            std::optional<T> next = f(current);
+            if (!next || !Pred(*next))
+                return std::nullopt;
+            if (value_.compare_exchange_weak(current, *next, order,
+                                             detail::load_order(order)))
+                return value_type(current, assume_valid);
+        }
+    }
+
+    // As fetch_update, but returns the value that was stored
+    template <typename F>
+        requires std::convertible_to<std::invoke_result_t<F&, const T&>,
+                                     std::optional<T>>
+    std::optional<value_type>
+    update(F f, std::memory_order order = std::memory_order::seq_cst) noexcept(
+        std::is_nothrow_invocable_v<F&, const T&>) {
+        std::optional<T> stored;
+        auto previous = fetch_update(
+            [&](const T& v) -> std::optional<T> {
+                stored = f(v);
+                return stored;
+            },
+            order);
+        if (!previous)
+            return std::nullopt;
+        return value_type(*stored, assume_valid);
+    }
+
+    // Add delta unless the sum overflows or fails Pred; returns the
+    // previous value on success
+    std::optional<value_type>
+    fetch_add(T delta,
+              std::memory_order order = std::memory_order::seq_cst) noexcept
+        requires std::is_arithmetic_v<T> && (!std::same_as<T, bool>)
+    {
+        return fetch_update(
+            [delta](T v) { return detail::add_no_overflow(v, delta); }, order);
+    }
+
+    std::optional<value_type>
+    fetch_sub(T delta,
+              std::memory_order order = std::memory_order::seq_cst) noexcept
+        requires std::is_arithmetic_v<T> && (!std::same_as<T, bool>)
+    {
+        return fetch_update(
+            [delta](T v) { return detail::sub_no_overflow(v, delta); }, order);
+    }
+};
+
+} // namespace refinery
+
+#endif // REFINERY_ATOMIC_HPP
@@ -0,0 +1,327 @@
+// bounded.hpp - Fixed-capacity inline containers for size-bounded refinements
+// Part of the C++26 Refinement Types Library
+//
+// A Refined<std::vector<T>, SizeAtMost(8)> knows it never holds more than
+// eight elements but still allocates them on the heap. BoundedVector<T, N>
+// and BoundedString<N> keep up to N elements inline, never allocate, and
+// convert from the refined standard containers without a check when the
+// refinement already bounds the size by N:
+//
+//   using Tags = Refined<std::vector<Tag>, SizeAtMost(8)>;
+//   BoundedVector<Tag, 8> inline_tags = tags;          // no check, no heap
+//
+//   BoundedString<32> symbol;
+//   symbol.append("AAPL");                              // throws if > 32
+//   if (!symbol.try_append(suffix))                     // or reports it
+//       ...
+//   Refined<std::string, SizeAtMost(32)> s = symbol.to_string();
+//
+// The conversions accept containers refined with SizeAtMost(M),
+// SizeInRange(L, M) or SizeExactly(M) for any M <= N; the bound is read
+// from the predicate at compile time. Anything else goes through from(),
+// which checks the size once.
+//
+// push_back and append throw refinement_error past capacity; the try_
+// forms return false instead, and unchecked_push_back is for loops whose
+// own bound already keeps them within N.
+
+#ifndef REFINERY_BOUNDED_HPP
+#define REFINERY_BOUNDED_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "predicates.hpp"
+#include "refined_type.hpp"
+
+namespace refinery {
+
+namespace detail {
+
+// True if Pred (one of the size_interval_predicate forms) admits some
+// size and only sizes <= N. Each admits an interval of sizes, so that
+// holds exactly when N + 1 fails and some size <= N passes.
+template <auto Pred, std::size_t N> consteval bool size_bounded_by() {
+    if constexpr (!size_interval_predicate<Pred>) {
+        return false;
+    } else {
+        if (Pred(sized{N + 1}))
+            return false;
+        for (std::size_t k = 0; k <= N; ++k) {
+            if (Pred(sized{k}))
+                return true;
+        }
+        return false;
+    }
+}
+
+} // namespace detail
+
+// Refinement predicates that bound a container's size by N
+template <auto Pred, std::size_t N>
+concept bounded_by = detail::size_bounded_by<Pred, N>();
+
+template <typename T, std::size_t N> class BoundedVector {
+    static_assert(N > 0, "BoundedVector needs a capacity");
+
+    union {
+        T items_[N];
+    };
+    std::size_t size_ = 0;
+
+  public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+    static constexpr std::size_t capacity_v = N;
+
+    constexpr BoundedVector() noexcept {}
+
+    template <std::size_t K>
+        requires(K != std::dynamic_extent && K <= N)
+    constexpr BoundedVector(std::span<const T, K> values) {
+        for (const T& v : values)
+            unchecked_push_back(v);
+    }
+
+    template <auto Pred>
+        requires bounded_by<Pred, N>
+    constexpr BoundedVector(const Refined<std::vector<T>, Pred>& values) {
+        for (const T& v : values.get())
+            unchecked_push_back(v);
+    }
+
+    // values as a BoundedVector, or nullopt if there are more than N
+    [[nodiscard]] static constexpr std::optional<BoundedVector>
+    from(std::span<const T> values) {
+        if (values.size() > N)
+            return std::nullopt;
+        BoundedVector out;
+        for (const T& v : values)
+            out.unchecked_push_back(v);
+        return out;
+    }
+
+    constexpr BoundedVector(const BoundedVector& other) {
+        for (const T& v : other)
+            unchecked_push_back(v);
+    }
+    constexpr BoundedVector(BoundedVector&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>) {
+        for (T& v : other)
+            unchecked_push_back(std::move(v));
+    }
+    constexpr BoundedVector& operator=(const BoundedVector& other) {
+        if (this != &other) {
+            clear();
+            for (const T& v : other)
+                unchecked_push_back(v);
+        }
+        return *this;
+    }
+    constexpr BoundedVector& operator=(BoundedVector&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            for (T& v : other)
+                unchecked_push_back(std::move(v));
+        }
+        return *this;
+    }
+    constexpr ~BoundedVector() { clear(); }
+
+    // --- Adding elements ---
+
+    // Precondition: size() < N
+    template <typename... Args>
+    constexpr T& unchecked_emplace_back(Args&&... args) {
+        T* slot =
+            std::construct_at(items_ + size_, std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+    constexpr T& unchecked_push_back(const T& v) {
+        return unchecked_emplace_back(v);
+    }
+    constexpr T& unchecked_push_back(T&& v) {
+        return unchecked_emplace_back(std::move(v));
+    }
+
+    template <typename... Args>
+    [[nodiscard]] constexpr bool try_emplace_back(Args&&... args) {
+        if (size_ == N)
+            return false;
+        unchecked_emplace_back(std::forward<Args>(args)...);
+        return true;
+    }
+    [[nodiscard]] constexpr bool try_push_back(const T& v) {
+        return try_emplace_back(v);
+    }
+    [[nodiscard]] constexpr bool try_push_back(T&& v) {
+        return try_emplace_back(std::move(v));
+    }
+
+    template <typename... Args> constexpr T& emplace_back(Args&&... args) {
+        if (size_ == N)
+            throw refinement_error(
+                std::string("BoundedVector capacity exceeded"));
+        return unchecked_emplace_back(std::forward<Args>(args)...);
+    }
+    constexpr T& push_back(const T& v) { return emplace_back(v); }
+    constexpr T& push_back(T&& v) { return emplace_back(std::move(v)); }
+
+    // --- Removing elements ---
+
+    constexpr void pop_back() noexcept { std::destroy_at(items_ + --size_); }
+
+    constexpr void clear() noexcept {
+        std::destroy(items_, items_ + size_);
+        size_ = 0;
+    }
+
+    // --- Access ---
+
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] static constexpr std::size_t capacity() noexcept {
+        return N;
+    }
+
+    [[nodiscard]] constexpr T* data() noexcept { return items_; }
+    [[nodiscard]] constexpr const T* data() const noexcept { return items_; }
+    [[nodiscard]] constexpr T& operator[](std::size_t i) noexcept {
+        return items_[i];
+    }
+    [[nodiscard]] constexpr const T& operator[](std::size_t i) const noexcept {
+        return items_[i];
+    }
+    [[nodiscard]] constexpr T* begin() noexcept { return items_; }
+    [[nodiscard]] constexpr T* end() noexcept { return items_ + size_; }
+    [[nodiscard]] constexpr const T* begin() const noexcept { return items_; }
+    [[nodiscard]] constexpr const T* end() const noexcept {
+        return items_ + size_;
+    }
+
+    // A heap copy, refined with the bound this vector guarantees
+    [[nodiscard]] Refined<std::vector<T>, SizeAtMost(N)> to_vector() const {
+        return Refined<std::vector<T>, SizeAtMost(N)>(
+            std::vector<T>(begin(), end()), assume_valid);
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(const BoundedVector& a,
+                                                   const BoundedVector& b) {
+        return std::ranges::equal(a, b);
+    }
+};
+
+template <std::size_t N> class BoundedString {
+    static_assert(N > 0, "BoundedString needs a capacity");
+
+    char chars_[N];
+    std::size_t size_ = 0;
+
+  public:
+    using value_type = char;
+    static constexpr std::size_t capacity_v = N;
+
+    constexpr BoundedString() noexcept : chars_{} {}
+
+    // String literals that fit; longer ones do not compile
+    template <std::size_t K>
+        requires(K - 1 <= N)
+    constexpr BoundedString(const char (&literal)[K]) noexcept : chars_{} {
+        unchecked_append(std::string_view(literal, K - 1));
+    }
+
+    template <auto Pred>
+        requires bounded_by<Pred, N>
+    constexpr BoundedString(const Refined<std::string, Pred>& s) noexcept
+        : chars_{} {
+        unchecked_append(s.get());
+    }
+
+    // s as a BoundedString, or nullopt if it is longer than N
+    [[nodiscard]] static constexpr std::optional<BoundedString>
+    from(std::string_view s) noexcept {
+        if (s.size() > N)
+            return std::nullopt;
+        BoundedString out;
+        out.unchecked_append(s);
+        return out;
+    }
+
+    // Precondition: size() + s.size() <= N
+    constexpr void unchecked_append(std::string_view s) noexcept {
+        std::copy(s.begin(), s.end(), chars_ + size_);
+        size_ += s.size();
+    }
+
+    [[nodiscard]] constexpr bool try_append(std::string_view s) noexcept {
+        if (s.size() > N - size_)
+            return false;
+        unchecked_append(s);
+        return true;
+    }
+
+    constexpr BoundedString& append(std::string_view s) {
+        if (!try_append(s))
+            throw refinement_error(
+                std::string("BoundedString capacity exceeded"));
+        return *this;
+    }
+
+    [[nodiscard]] constexpr bool try_push_back(char c) noexcept {
+        return try_append(std::string_view(&c, 1));
+    }
+    constexpr void push_back(char c) { append(std::string_view(&c, 1)); }
+
+    constexpr void clear() noexcept { size_ = 0; }
+
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] static constexpr std::size_t capacity() noexcept {
+        return N;
+    }
+    [[nodiscard]] constexpr const char* data() const noexcept {
+        return chars_;
+    }
+    [[nodiscard]] constexpr char operator[](std::size_t i) const noexcept {
+        return chars_[i];
+    }
+    [[nodiscard]] constexpr const char* begin() const noexcept {
+        return chars_;
+    }
+    [[nodiscard]] constexpr const char* end() const noexcept {
+        return chars_ + size_;
+    }
+
+    [[nodiscard]] constexpr std::string_view view() const noexcept {
+        return {chars_, size_};
+    }
+    [[nodiscard]] constexpr operator std::string_view() const noexcept {
+        return view();
+    }
+
+    // A heap copy, refined with the bound this string guarantees
+    [[nodiscard]] Refined<std::string, SizeAtMost(N)> to_string() const {
+        return Refined<std::string, SizeAtMost(N)>(std::string(view()),
+                                                   assume_valid);
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(const BoundedString& a,
+                                                   std::string_view b) {
+        return a.view() == b;
+    }
+};
+
+} // namespace refinery
+
+#endif // REFINERY_BOUNDED_HPP
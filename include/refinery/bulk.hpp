@@ -0,0 +1,227 @@
+// bulk.hpp - Validating whole arrays of values, sequentially or in parallel
+// Part of the C++26 Refinement Types Library
+//
+// Checks a span of raw values against a refined type's predicate in one
+// call. Each function has a sequential form and a parallel form that takes
+// a WorkStealingPool and splits the span into chunks across its threads:
+//
+//   std::span<const std::int32_t> raw = load_ids();
+//   WorkStealingPool pool;
+//   if (auto ids = refine_all<PositiveI32>(pool, raw))  // all or nothing
+//       index(*ids);
+//   auto [kept, dropped] = partition_valid<PositiveI32>(pool, raw);
+//   std::size_t bad = count_invalid<PositiveI32>(pool, raw);
+//
+// all_valid and refine_all stop every thread as soon as one value fails.
+// count_invalid and partition_valid always look at every value;
+// partition_valid keeps the input order in both of its outputs.
+//
+// Validation scales with the pool. Building the result vectors of
+// refine_all and partition_valid is a sequential copy once the checks are
+// done, since a vector of refined values cannot be sized without values to
+// put in it.
+
+#ifndef REFINERY_BULK_HPP
+#define REFINERY_BULK_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "parallel.hpp"
+#include "refined_type.hpp"
+
+namespace refinery {
+
+// Result of partition_valid: the values that satisfy the predicate, and the
+// indices of those that do not, both in input order
+template <typename R> struct partitioned_values {
+    std::vector<R> values;
+    std::vector<std::size_t> rejected;
+};
+
+namespace detail::bulk {
+
+// Values per parallel chunk: large enough to amortize a steal, small enough
+// that cancellation is prompt and stealing can balance the load
+inline constexpr std::size_t grain = std::size_t{1} << 14;
+
+// Index of the first value failing Pred, or values.size(). Checks a block
+// at a time without branching so the common all-valid case vectorizes.
+template <auto Pred, typename T>
+std::size_t first_failing(std::span<const T> values) noexcept {
+    constexpr std::size_t block = 64;
+    for (std::size_t i = 0; i < values.size(); i += block) {
+        const std::size_t end = std::min(values.size(), i + block);
+        bool ok = true;
+        for (std::size_t j = i; j < end; ++j)
+            ok &= static_cast<bool>(Pred(values[j]));
+        if (ok)
+            continue;
+        for (std::size_t j = i; j < end; ++j) {
+            if (!Pred(values[j]))
+                return j;
+        }
+    }
+    return values.size();
+}
+
+template <auto Pred, typename T>
+std::size_t count_failing(std::span<const T> values) noexcept {
+    std::size_t failing = 0;
+    for (const T& v : values)
+        failing += Pred(v) ? 0 : 1;
+    return failing;
+}
+
+template <typename R, typename T>
+void append_valid(std::span<const T> values, std::size_t offset,
+                  partitioned_values<R>& out) {
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (R::predicate(values[i]))
+            out.values.push_back(R(values[i], assume_valid));
+        else
+            out.rejected.push_back(offset + i);
+    }
+}
+
+template <typename R, typename T>
+std::vector<R> wrap_all(std::span<const T> values) {
+    std::vector<R> out;
+    out.reserve(values.size());
+    std::ranges::transform(values, std::back_inserter(out),
+                           [](const T& v) { return R(v, assume_valid); });
+    return out;
+}
+
+inline std::size_t chunk_count(std::size_t n) noexcept {
+    return (n + grain - 1) / grain;
+}
+
+// The values of chunk c
+template <typename T>
+std::span<const T> chunk(std::span<const T> values, std::size_t c) noexcept {
+    const std::size_t begin = c * grain;
+    return values.subspan(begin, std::min(grain, values.size() - begin));
+}
+
+} // namespace detail::bulk
+
+// --- Sequential ---
+
+template <typename R>
+    requires is_refined<R>
+[[nodiscard]] bool
+all_valid(std::span<const typename R::value_type> values) noexcept {
+    return detail::bulk::first_failing<R::predicate>(values) == values.size();
+}
+
+template <typename R>
+    requires is_refined<R>
+[[nodiscard]] std::size_t
+count_invalid(std::span<const typename R::value_type> values) noexcept {
+    return detail::bulk::count_failing<R::predicate>(values);
+}
+
+// Every value refined, or nullopt if any fails the predicate
+template <typename R>
+    requires is_refined<R>
+[[nodiscard]] std::optional<std::vector<R>>
+refine_all(std::span<const typename R::value_type> values) {
+    if (!all_valid<R>(values))
+        return std::nullopt;
+    return detail::bulk::wrap_all<R>(values);
+}
+
+template <typename R>
+    requires is_refined<R>
+[[nodiscard]] partitioned_values<R>
+partition_valid(std::span<const typename R::value_type> values) {
+    partitioned_values<R> out;
+    out.values.reserve(values.size());
+    detail::bulk::append_valid(values, 0, out);
+    return out;
+}
+
+// --- Parallel ---
+
+template <typename R>
+    requires is_refined<R>
+[[nodiscard]] bool all_valid(WorkStealingPool& pool,
+                             std::span<const typename R::value_type> values) {
+    if (pool.size() == 1 || values.size() <= detail::bulk::grain)
+        return all_valid<R>(values);
+    return pool.for_each_chunk(
+        detail::bulk::chunk_count(values.size()), [values](std::size_t c) {
+            return all_valid<R>(detail::bulk::chunk(values, c));
+        });
+}
+
+template <typename R>
+    requires is_refined<R>
+[[nodiscard]] std::size_t
+count_invalid(WorkStealingPool& pool,
+              std::span<const typename R::value_type> values) {
+    if (pool.size() == 1 || values.size() <= detail::bulk::grain)
+        return count_invalid<R>(values);
+    std::atomic<std::size_t> total{0};
+    const std::size_t chunks = detail::bulk::chunk_count(values.size());
+    pool.for_each_chunk(chunks, [values, &total](std::size_t c) {
+        auto slice = detail::bulk::chunk(values, c);
+        total.fetch_add(count_invalid<R>(slice), std::memory_order::relaxed);
+        return true;
+    });
+    return total.load(std::memory_order::relaxed);
+}
+
+template <typename R>
+    requires is_refined<R>
+[[nodiscard]] std::optional<std::vector<R>>
+refine_all(WorkStealingPool& pool,
+           std::span<const typename R::value_type> values) {
+    if (!all_valid<R>(pool, values))
+        return std::nullopt;
+    return detail::bulk::wrap_all<R>(values);
+}
+
+template <typename R>
+    requires is_refined<R>
+[[nodiscard]] partitioned_values<R>
+partition_valid(WorkStealingPool& pool,
+                std::span<const typename R::value_type> values) {
+    if (pool.size() == 1 || values.size() <= detail::bulk::grain)
+        return partition_valid<R>(values);
+    std::vector<partitioned_values<R>> parts(
+        detail::bulk::chunk_count(values.size()));
+    pool.for_each_chunk(parts.size(), [values, &parts](std::size_t c) {
+        auto slice = detail::bulk::chunk(values, c);
+        parts[c].values.reserve(slice.size());
+        detail::bulk::append_valid(slice, c * detail::bulk::grain, parts[c]);
+        return true;
+    });
+
+    partitioned_values<R> out;
+    std::size_t kept = 0;
+    std::size_t dropped = 0;
+    for (const auto& part : parts) {
+        kept += part.values.size();
+        dropped += part.rejected.size();
+    }
+    out.values.reserve(kept);
+    out.rejected.reserve(dropped);
+    for (const auto& part : parts) {
+        out.values.insert(out.values.end(), part.values.begin(),
+                          part.values.end());
+        out.rejected.insert(out.rejected.end(), part.rejected.begin(),
+                            part.rejected.end());
+    }
+    return out;
+}
+
+} // namespace refinery
+
+#endif // REFINERY_BULK_HPP
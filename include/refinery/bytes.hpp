@@ -0,0 +1,205 @@
+// bytes.hpp - Byte-buffer views that carry a minimum size for bounds-free reads
+// Part of the C++26 Refinement Types Library
+//
+// RefinedBytes<N> is a std::span<const std::byte> refined with
+// SizeAtLeast(N). Once a buffer has been checked to hold N bytes, reads at
+// fixed offsets below N need no bounds check, and the guarantee follows
+// the view as it is advanced or split:
+//
+//   auto packet = refine_bytes<8>(datagram);         // one runtime check
+//   if (!packet)
+//       return drop();
+//   auto kind = packet->read<std::uint16_t, 0, std::endian::big>();
+//   auto length = packet->read<std::uint16_t, 2, std::endian::big>();
+//   auto port = packet->read_refined<PortNumber<std::uint16_t>, 4,
+//                                    std::endian::big>();   // optional
+//   auto body = packet->advance<8>().take<4>(length);  // one runtime check
+//   if (!body)
+//       return drop();
+//   auto [payload, rest] = *body;                      // rest: RefinedBytes<4>
+//
+// read<T, Offset>, first<K>, advance<K> and split<K> are only declared for
+// offsets and sizes within N, so a read past the checked prefix does not
+// compile. Widening the guarantee takes one runtime check, either for a
+// fixed size (require<M>) or for a variable-length section followed by a
+// fixed one (take<M>(n)). A RefinedBytes<N> converts implicitly to any
+// RefinedBytes<M> with M <= N.
+//
+// Multi-byte reads use memcpy and std::byteswap, so they are safe at any
+// alignment and compile to a plain (or byte-swapping) load.
+
+#ifndef REFINERY_BYTES_HPP
+#define REFINERY_BYTES_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "predicates.hpp"
+#include "refined_type.hpp"
+
+namespace refinery {
+
+// Types that can be loaded from a byte buffer: arithmetic types and enums
+// of at most 8 bytes
+template <typename T>
+concept byte_scalar =
+    (std::is_arithmetic_v<T> || std::is_enum_v<T>) && sizeof(T) <= 8;
+
+namespace detail {
+
+template <std::size_t N> struct uint_of_size;
+template <> struct uint_of_size<1> {
+    using type = std::uint8_t;
+};
+template <> struct uint_of_size<2> {
+    using type = std::uint16_t;
+};
+template <> struct uint_of_size<4> {
+    using type = std::uint32_t;
+};
+template <> struct uint_of_size<8> {
+    using type = std::uint64_t;
+};
+
+// Load a T stored at p in byte order Order
+template <byte_scalar T, std::endian Order>
+T load_scalar(const std::byte* p) noexcept {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    if constexpr (Order != std::endian::native && sizeof(T) > 1) {
+        using U = typename uint_of_size<sizeof(T)>::type;
+        value = std::bit_cast<T>(std::byteswap(std::bit_cast<U>(value)));
+    }
+    return value;
+}
+
+} // namespace detail
+
+template <std::size_t N> class RefinedBytes {
+  public:
+    using refined_type = Refined<std::span<const std::byte>, SizeAtLeast(N)>;
+    static constexpr std::size_t min_size = N;
+
+  private:
+    refined_type bytes_;
+
+    template <std::size_t> friend class RefinedBytes;
+
+    explicit RefinedBytes(std::span<const std::byte> bytes) noexcept
+        : bytes_(bytes, assume_valid) {}
+
+  public:
+    explicit RefinedBytes(refined_type bytes) noexcept : bytes_(bytes) {}
+
+    // A span whose static extent covers N needs no check
+    template <std::size_t Extent>
+        requires(Extent != std::dynamic_extent && Extent >= N)
+    RefinedBytes(std::span<const std::byte, Extent> bytes) noexcept
+        : bytes_(bytes, assume_valid) {}
+
+    // Forget part of a larger guarantee
+    template <std::size_t M>
+        requires(M > N)
+    RefinedBytes(const RefinedBytes<M>& other) noexcept
+        : bytes_(other.bytes(), assume_valid) {}
+
+    // nullopt unless bytes holds at least N bytes
+    [[nodiscard]] static std::optional<RefinedBytes>
+    check(std::span<const std::byte> bytes) noexcept {
+        if (bytes.size() < N)
+            return std::nullopt;
+        return RefinedBytes(bytes);
+    }
+
+    [[nodiscard]] const refined_type& get() const noexcept { return bytes_; }
+    [[nodiscard]] std::span<const std::byte> bytes() const noexcept {
+        return bytes_.get();
+    }
+    [[nodiscard]] const std::byte* data() const noexcept {
+        return bytes_->data();
+    }
+    [[nodiscard]] std::size_t size() const noexcept { return bytes_->size(); }
+
+    // --- Fixed-offset access within the checked prefix (no bounds checks) ---
+
+    template <byte_scalar T, std::size_t Offset,
+              std::endian Order = std::endian::little>
+        requires(Offset <= N && sizeof(T) <= N - Offset)
+    [[nodiscard]] T read() const noexcept {
+        return detail::load_scalar<T, Order>(data() + Offset);
+    }
+
+    // The field at Offset as R, or nullopt if it fails R's predicate
+    template <typename R, std::size_t Offset,
+              std::endian Order = std::endian::little>
+        requires is_refined<R> && byte_scalar<typename R::value_type> &&
+                 (Offset <= N && sizeof(typename R::value_type) <= N - Offset)
+    [[nodiscard]] std::optional<R> read_refined() const noexcept {
+        return try_refine<R>(read<typename R::value_type, Offset, Order>());
+    }
+
+    template <std::size_t K>
+        requires(K <= N)
+    [[nodiscard]] std::span<const std::byte, K> first() const noexcept {
+        return bytes_->template first<K>();
+    }
+
+    template <std::size_t Offset, std::size_t K>
+        requires(Offset <= N && K <= N - Offset)
+    [[nodiscard]] std::span<const std::byte, K> subspan() const noexcept {
+        return bytes_->template subspan<Offset, K>();
+    }
+
+    // The bytes after the first K
+    template <std::size_t K>
+        requires(K <= N)
+    [[nodiscard]] RefinedBytes<N - K> advance() const noexcept {
+        return RefinedBytes<N - K>(bytes_->subspan(K));
+    }
+
+    // The first K bytes, and the rest
+    template <std::size_t K>
+        requires(K <= N)
+    [[nodiscard]] std::pair<RefinedBytes<K>, RefinedBytes<N - K>>
+    split() const noexcept {
+        return {RefinedBytes<K>(bytes_->first(K)),
+                RefinedBytes<N - K>(bytes_->subspan(K))};
+    }
+
+    // --- Widening the guarantee (one runtime check each) ---
+
+    template <std::size_t M>
+        requires(M > N)
+    [[nodiscard]] std::optional<RefinedBytes<M>> require() const noexcept {
+        return RefinedBytes<M>::check(bytes());
+    }
+
+    // A variable-length section of n bytes, and the rest, which must hold
+    // at least M more bytes; nullopt if the buffer is too short for both
+    template <std::size_t M = 0>
+    [[nodiscard]] std::optional<
+        std::pair<std::span<const std::byte>, RefinedBytes<M>>>
+    take(std::size_t n) const noexcept {
+        if (n > size() || size() - n < M)
+            return std::nullopt;
+        return std::pair{bytes_->first(n),
+                         RefinedBytes<M>(bytes_->subspan(n))};
+    }
+};
+
+// bytes as RefinedBytes<N>, or nullopt if it holds fewer than N bytes
+template <std::size_t N>
+[[nodiscard]] std::optional<RefinedBytes<N>>
+refine_bytes(std::span<const std::byte> bytes) noexcept {
+    return RefinedBytes<N>::check(bytes);
+}
+
+} // namespace refinery
+
+#endif // REFINERY_BYTES_HPP
@@ -0,0 +1,162 @@
+// charconv.hpp - Text conversion of refined values
+// Part of the C++26 Refinement Types Library
+//
+// parse_refined<R>(text) parses and validates in a single pass, with the
+// same syntax as std::from_chars (no leading '+' or whitespace, and the whole
+// string must be consumed):
+//
+//   auto port = parse_refined<PortNumber<>>(argv[1]);
+//   if (!port)
+//       report(port.error());   // parse_error::out_of_range, ...
+//
+// For integral T refined by an Interval<Lo, Hi>, the bounds are folded into
+// the digit loop: a digit that would take the magnitude past Hi (or past
+// |Lo| for negative input) rejects immediately, so oversized input such as
+// "99999999999" for a port number is rejected at its fifth digit instead of
+// being accumulated, overflow-checked and then compared.
+//
+// to_chars(first, last, refined) is the reverse direction. For
+// interval-refined integers it writes at most max_chars_v<R> characters,
+// using the bounds to skip sign handling and size its buffer; the
+// std::formatter for Refined takes the same path for "{}".
+
+#ifndef REFINERY_CHARCONV_HPP
+#define REFINERY_CHARCONV_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <expected>
+#include <limits>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "interval.hpp"
+#include "refined_type.hpp"
+
+namespace refinery {
+
+// Why parse_refined rejected its input
+enum class parse_error {
+    invalid_syntax,   // not a number, or trailing characters
+    out_of_range,     // outside T or outside an interval predicate's bounds
+    predicate_failed, // a non-interval predicate rejected the value
+};
+
+namespace detail {
+
+// Parse an integer in [Lo, Hi], rejecting as soon as the accumulated
+// magnitude can no longer end up inside the bounds (strtol-style cutoff).
+template <std::integral T, T Lo, T Hi>
+constexpr std::expected<T, parse_error>
+parse_bounded(std::string_view text) noexcept {
+    using U = std::make_unsigned_t<T>;
+    // Largest magnitude that can still land in [Lo, Hi] for each sign
+    constexpr U pos_limit = Hi > 0 ? static_cast<U>(Hi) : U{0};
+    constexpr U neg_limit = Lo < 0 ? static_cast<U>(U{0} - static_cast<U>(Lo))
+                                   : U{0};
+
+    const char* p = text.data();
+    const char* const end = p + text.size();
+    bool negative = false;
+    if constexpr (std::is_signed_v<T>) {
+        if (p != end && *p == '-') {
+            negative = true;
+            ++p;
+        }
+    }
+    if (p == end)
+        return std::unexpected(parse_error::invalid_syntax);
+
+    const U cutoff = (negative ? neg_limit : pos_limit) / 10;
+    const unsigned cutlim =
+        static_cast<unsigned>((negative ? neg_limit : pos_limit) % 10);
+    U acc = 0;
+    for (; p != end; ++p) {
+        unsigned digit = static_cast<unsigned char>(*p) - unsigned{'0'};
+        if (digit > 9)
+            return std::unexpected(parse_error::invalid_syntax);
+        if (acc > cutoff || (acc == cutoff && digit > cutlim))
+            return std::unexpected(parse_error::out_of_range);
+        acc = static_cast<U>(acc * 10 + digit);
+    }
+
+    T value = negative ? static_cast<T>(U{0} - acc) : static_cast<T>(acc);
+    if (value < Lo || value > Hi)
+        return std::unexpected(parse_error::out_of_range);
+    return value;
+}
+
+} // namespace detail
+
+// Parse text into a refined value. Integral and floating-point value types
+// are supported; the syntax is that of std::from_chars.
+template <typename R>
+    requires is_refined<R> &&
+             (std::floating_point<typename R::value_type> ||
+              (std::integral<typename R::value_type> &&
+               !std::same_as<typename R::value_type, bool>))
+[[nodiscard]] constexpr std::expected<R, parse_error>
+parse_refined(std::string_view text) noexcept {
+    using T = typename R::value_type;
+    constexpr auto pred = R::predicate;
+
+    if constexpr (detail::clamped_interval<T, pred>) {
+        constexpr T lo = detail::clamp_bound<T, pred.lo>();
+        constexpr T hi = detail::clamp_bound<T, pred.hi>();
+        auto parsed = detail::parse_bounded<T, lo, hi>(text);
+        if (!parsed)
+            return std::unexpected(parsed.error());
+        return R(*parsed, assume_valid);
+    } else {
+        T value{};
+        const char* const end = text.data() + text.size();
+        auto [ptr, ec] = std::from_chars(text.data(), end, value);
+        if (ec == std::errc::result_out_of_range)
+            return std::unexpected(parse_error::out_of_range);
+        if (ec != std::errc{} || ptr != end)
+            return std::unexpected(parse_error::invalid_syntax);
+        if (!R::predicate(value))
+            return std::unexpected(interval_predicate<pred>
+                                       ? parse_error::out_of_range
+                                       : parse_error::predicate_failed);
+        return R(std::move(value), assume_valid);
+    }
+}
+
+// Largest number of characters to_chars can produce for an interval-refined
+// integer type R, e.g. 3 for Refined<int, Interval<0, 999>{}>
+template <typename R>
+    requires is_refined<R> &&
+             detail::bounded_integral<typename R::value_type, R::predicate>
+inline constexpr std::size_t max_chars_v =
+    detail::bounded_format<typename R::value_type, R::predicate>::max_chars;
+
+// Write a refined value as text. Interval-refined integers use a digit-pair
+// writer specialized to the interval's width and sign; other types, and
+// values outside the interval, forward to std::to_chars.
+template <typename T, auto Pred>
+constexpr std::to_chars_result to_chars(char* first, char* last,
+                                        const Refined<T, Pred>& value) {
+    if constexpr (detail::bounded_integral<T, Pred>) {
+        using layout = detail::bounded_format<T, Pred>;
+        if (!layout::in_bounds(value.get()))
+            return std::to_chars(first, last, value.get());
+        if (last - first >= static_cast<std::ptrdiff_t>(layout::max_chars))
+            return {layout::write(first, value.get()), std::errc{}};
+        char buf[layout::max_chars];
+        char* end = layout::write(buf, value.get());
+        if (end - buf > last - first)
+            return {last, std::errc::value_too_large};
+        return {std::copy(buf, end, first), std::errc{}};
+    } else {
+        return std::to_chars(first, last, value.get());
+    }
+}
+
+} // namespace refinery
+
+#endif // REFINERY_CHARCONV_HPP
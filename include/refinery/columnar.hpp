@@ -0,0 +1,354 @@
+// columnar.hpp - Bulk parsing of numeric text columns into refined values
+// Part of the C++26 Refinement Types Library
+//
+// parse_column<R>(text) splits a column of numbers (one per line, as found
+// in a single-column CSV/TSV extract) and parses every field straight into
+// R, checking R's predicate in the same pass:
+//
+//   auto col = parse_column<IntervalRefined<std::int32_t, 0, 100'000>>(text);
+//   use(col.values);            // std::vector<R>, accepted rows in order
+//   log_bad_rows(col.rejected); // 0-based row indices that failed
+//
+// The scan works a block at a time: delimiters are located 64 bytes per
+// step with SSE2/AVX2 compares, and digits are classified and converted
+// eight at a time inside a 64-bit register (SWAR). For integral T refined by
+// an Interval the bounds are applied to the accumulated magnitude, so no
+// second validation pass is needed. Decimal fields ("-12.375") take an exact
+// fast path when the significand and the scale are small enough for a
+// single correctly rounded division; anything else (exponents, inf/nan,
+// very long inputs) falls back to std::from_chars.
+
+#ifndef REFINERY_COLUMNAR_HPP
+#define REFINERY_COLUMNAR_HPP
+
+#include <array>
+#include <bit>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include "charconv.hpp"
+#include "interval.hpp"
+#include "refined_type.hpp"
+
+#if defined(__SSE2__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace refinery {
+
+// Result of parse_column: the accepted values in row order, and the indices
+// of the rows that did not parse or did not satisfy the predicate
+template <typename R> struct parsed_column {
+    std::vector<R> values;
+    std::vector<std::size_t> rejected;
+};
+
+namespace detail::columnar {
+
+inline constexpr std::uint64_t ones = 0x0101010101010101;
+
+// Longest digit run that cannot overflow a uint64_t accumulator
+inline constexpr std::size_t max_fast_digits = 19;
+
+inline constexpr std::array<std::uint64_t, 20> pow10 = [] {
+    std::array<std::uint64_t, 20> p{};
+    p[0] = 1;
+    for (std::size_t i = 1; i < p.size(); ++i)
+        p[i] = p[i - 1] * 10;
+    return p;
+}();
+
+// Load 8 bytes in memory order (byte 0 in the low bits). Bytes past end
+// read as zero, which is not a digit.
+inline std::uint64_t load8(const char* p, const char* end) noexcept {
+    std::uint64_t chunk = 0;
+    if (end - p >= 8)
+        std::memcpy(&chunk, p, 8);
+    else
+        std::memcpy(&chunk, p, static_cast<std::size_t>(end - p));
+    if constexpr (std::endian::native == std::endian::big)
+        chunk = std::byteswap(chunk);
+    return chunk;
+}
+
+// Number of leading bytes of chunk that are '0'-'9'. A byte is a digit when
+// its high nibble is 3 both before and after adding 6. Carries out of a
+// byte only come from non-digits and only disturb later bytes, so the
+// position of the first non-digit is exact.
+inline unsigned digit_run(std::uint64_t chunk) noexcept {
+    const std::uint64_t high = ones * 0xf0;
+    const std::uint64_t three = ones * 0x30;
+    std::uint64_t bad = ((chunk & high) ^ three) |
+                        (((chunk + ones * 0x06) & high) ^ three);
+    return static_cast<unsigned>(std::countr_zero(bad)) / 8;
+}
+
+// Value of the first count (1-8) digits of chunk, converted in-register
+inline std::uint64_t parse_digits(std::uint64_t chunk,
+                                  unsigned count) noexcept {
+    // Move the digits to the top and pad the front with '0'
+    if (count < 8) {
+        unsigned shift = 8 * (8 - count);
+        chunk = (chunk << shift) | ((ones * '0') >> (64 - shift));
+    }
+    chunk -= ones * '0';
+    chunk = chunk * 10 + (chunk >> 8); // pairs of digits
+    chunk = (((chunk & 0x000000ff000000ff) * (100 + (1000000ull << 32))) +
+             (((chunk >> 16) & 0x000000ff000000ff) *
+              (1 + (10000ull << 32)))) >>
+            32;
+    return chunk;
+}
+
+// Accumulate the digit run at p (stopping at field_end) into acc and
+// advance p. Returns the number of digits consumed, or max_fast_digits + 1
+// if the run would not fit in acc.
+inline std::size_t accumulate_digits(const char*& p, const char* field_end,
+                                     const char* buffer_end,
+                                     std::uint64_t& acc,
+                                     std::size_t consumed = 0) noexcept {
+    while (true) {
+        std::uint64_t chunk = load8(p, buffer_end);
+        unsigned count = digit_run(chunk);
+        auto left = static_cast<std::size_t>(field_end - p);
+        if (count > left)
+            count = static_cast<unsigned>(left);
+        if (count == 0)
+            return consumed;
+        if (consumed + count > max_fast_digits)
+            return max_fast_digits + 1;
+        acc = acc * pow10[count] + parse_digits(chunk, count);
+        consumed += count;
+        p += count;
+        if (count < 8)
+            return consumed;
+    }
+}
+
+// Slow path for fields the fast paths do not cover
+template <typename T>
+bool parse_fallback(const char* begin, const char* end, T& out) noexcept {
+    auto [ptr, ec] = std::from_chars(begin, end, out);
+    return ec == std::errc{} && ptr == end;
+}
+
+template <typename T, auto Pred>
+bool parse_integral(const char* p, const char* end, const char* buffer_end,
+                    T& out) noexcept {
+    using U = std::make_unsigned_t<T>;
+    constexpr bool bounded = clamped_interval<T, Pred>;
+    constexpr T lo = [] {
+        if constexpr (bounded)
+            return clamp_bound<T, Pred.lo>();
+        else
+            return std::numeric_limits<T>::min();
+    }();
+    constexpr T hi = [] {
+        if constexpr (bounded)
+            return clamp_bound<T, Pred.hi>();
+        else
+            return std::numeric_limits<T>::max();
+    }();
+    // Largest magnitude that can still land in [lo, hi] for each sign
+    constexpr std::uint64_t pos_limit = hi > 0 ? static_cast<U>(hi) : 0;
+    constexpr std::uint64_t neg_limit =
+        lo < 0 ? static_cast<U>(U{0} - static_cast<U>(lo)) : 0;
+
+    const char* const begin = p;
+    bool negative = false;
+    if constexpr (std::is_signed_v<T>) {
+        if (p != end && *p == '-') {
+            negative = true;
+            ++p;
+        }
+    }
+    std::uint64_t magnitude = 0;
+    auto length = static_cast<std::size_t>(end - p);
+    if (length - 1 < 8) {
+        // Common case: the whole field is converted from one load
+        std::uint64_t chunk = load8(p, buffer_end);
+        if (digit_run(chunk) < length)
+            return false;
+        magnitude = parse_digits(chunk, static_cast<unsigned>(length));
+    } else {
+        std::size_t digits = accumulate_digits(p, end, buffer_end, magnitude);
+        if (digits > max_fast_digits)
+            return parse_fallback(begin, end, out) && Pred(out);
+        if (digits == 0 || p != end)
+            return false;
+    }
+    if (magnitude > (negative ? neg_limit : pos_limit))
+        return false;
+
+    out = negative ? static_cast<T>(U{0} - static_cast<U>(magnitude))
+                   : static_cast<T>(magnitude);
+    if constexpr (bounded)
+        return out >= lo && out <= hi;
+    else
+        return Pred(out);
+}
+
+// Exact decimal fast path: a significand below 2^digits divided by an
+// exactly representable power of ten rounds correctly in one operation.
+template <std::floating_point T>
+inline constexpr std::size_t max_exact_pow10 =
+    std::numeric_limits<T>::digits >= 53 ? 22 : 10;
+
+// Largest significand converted to T exactly: 2^digits, or every 64-bit
+// value once T has at least 64 significand bits (x87 long double, float128)
+template <std::floating_point T>
+inline constexpr std::uint64_t max_exact_significand = [] {
+    if constexpr (std::numeric_limits<T>::digits >= 64)
+        return std::numeric_limits<std::uint64_t>::max();
+    else
+        return std::uint64_t{1} << std::numeric_limits<T>::digits;
+}();
+
+template <typename T, auto Pred>
+bool parse_floating(const char* p, const char* end, const char* buffer_end,
+                    T& out) noexcept {
+    const char* const begin = p;
+    bool negative = false;
+    if (p != end && *p == '-') {
+        negative = true;
+        ++p;
+    }
+    std::uint64_t significand = 0;
+    std::size_t digits = accumulate_digits(p, end, buffer_end, significand);
+    std::size_t scale = 0;
+    if (digits <= max_fast_digits && p != end && *p == '.') {
+        ++p;
+        std::size_t whole = digits;
+        digits = accumulate_digits(p, end, buffer_end, significand, digits);
+        scale = digits - whole;
+    }
+    if (digits > max_fast_digits || p != end ||
+        scale > max_exact_pow10<T> ||
+        significand > max_exact_significand<T>)
+        return parse_fallback(begin, end, out) && Pred(out);
+    if (digits == 0)
+        return false;
+
+    out = static_cast<T>(significand) / static_cast<T>(pow10[scale]);
+    if (negative)
+        out = -out;
+    return Pred(out);
+}
+
+template <typename R>
+bool parse_field(const char* begin, const char* end, const char* buffer_end,
+                 typename R::value_type& out) noexcept {
+    using T = typename R::value_type;
+    if (begin != end && end[-1] == '\r')
+        --end;
+    if constexpr (std::integral<T>)
+        return parse_integral<T, R::predicate>(begin, end, buffer_end, out);
+    else
+        return parse_floating<T, R::predicate>(begin, end, buffer_end, out);
+}
+
+// Bit i set when p[i] == delim, for the first n (<= 64) bytes at p
+inline std::uint64_t delimiter_mask(const char* p, std::size_t n,
+                                    char delim) noexcept {
+    if (n < 64) {
+        char block[64] = {};
+        std::memcpy(block, p, n);
+        std::uint64_t valid = (std::uint64_t{1} << n) - 1;
+        return delimiter_mask(block, 64, delim) & valid;
+    }
+#if defined(__AVX2__)
+    const __m256i d = _mm256_set1_epi8(delim);
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+    auto lo_bits = static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, d)));
+    auto hi_bits = static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, d)));
+    return std::uint64_t{lo_bits} | (std::uint64_t{hi_bits} << 32);
+#elif defined(__SSE2__)
+    const __m128i d = _mm_set1_epi8(delim);
+    std::uint64_t mask = 0;
+    for (int i = 0; i < 4; ++i) {
+        __m128i bytes =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i));
+        auto bits = static_cast<std::uint16_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, d)));
+        mask |= std::uint64_t{bits} << (16 * i);
+    }
+    return mask;
+#else
+    std::uint64_t mask = 0;
+    for (std::size_t i = 0; i < 64; ++i)
+        mask |= std::uint64_t{p[i] == delim} << i;
+    return mask;
+#endif
+}
+
+} // namespace detail::columnar
+
+// Parse a delimiter-separated column of integers or decimals into R. A
+// trailing delimiter does not start an extra row, and a '\r' before each
+// delimiter is ignored. Field syntax is that of std::from_chars.
+template <typename R>
+    requires is_refined<R> &&
+             (std::floating_point<typename R::value_type> ||
+              (std::integral<typename R::value_type> &&
+               !std::same_as<typename R::value_type, bool>))
+[[nodiscard]] parsed_column<R> parse_column(std::string_view text,
+                                            char delimiter = '\n') {
+    using T = typename R::value_type;
+    parsed_column<R> out;
+    const char* const data = text.data();
+    const char* const buffer_end = data + text.size();
+    std::size_t row = 0;
+    std::size_t field_start = 0;
+
+    // Size the output once: counting delimiters is far cheaper than the
+    // reallocation copies and page faults of a growing vector
+    std::size_t rows = 0;
+    for (std::size_t block = 0; block < text.size(); block += 64) {
+        std::size_t n = text.size() - block < 64 ? text.size() - block : 64;
+        rows += static_cast<std::size_t>(std::popcount(
+            detail::columnar::delimiter_mask(data + block, n, delimiter)));
+    }
+    out.values.reserve(rows + 1);
+
+    auto emit = [&](std::size_t field_end) {
+        T value{};
+        if (detail::columnar::parse_field<R>(data + field_start,
+                                             data + field_end, buffer_end,
+                                             value))
+            out.values.push_back(R(value, assume_valid));
+        else
+            out.rejected.push_back(row);
+        ++row;
+    };
+
+    for (std::size_t block = 0; block < text.size(); block += 64) {
+        std::size_t n = text.size() - block < 64 ? text.size() - block : 64;
+        std::uint64_t mask =
+            detail::columnar::delimiter_mask(data + block, n, delimiter);
+        while (mask != 0) {
+            std::size_t pos =
+                block + static_cast<std::size_t>(std::countr_zero(mask));
+            emit(pos);
+            field_start = pos + 1;
+            mask &= mask - 1;
+        }
+    }
+    if (field_start < text.size())
+        emit(text.size());
+    return out;
+}
+
+} // namespace refinery
+
+#endif // REFINERY_COLUMNAR_HPP
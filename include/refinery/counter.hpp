@@ -0,0 +1,182 @@
+// counter.hpp - Lock-free bounded permit counter
+// Part of the C++26 Refinement Types Library
+//
+// BoundedCounter<N> hands out at most N permits, for admission control:
+//
+//   BoundedCounter<256> in_flight;
+//   if (in_flight.try_acquire()) {
+//       serve(request);
+//       in_flight.release();
+//   }
+//
+// The number of permits available is an AtomicRefined over Interval<0, N>,
+// so try_acquire and release are compare-and-swap loops that can never
+// take it outside [0, N]: an acquire that would go below zero fails, and a
+// release of more permits than were acquired is refused. Snapshots come
+// back as IntervalRefined<std::size_t, 0, N>.
+//
+// BoundedCounter<N, Shards> splits the permits across Shards cache-line
+// sized counters. Each thread starts at its own shard and moves on to the
+// others only when that one runs dry, so uncontended threads rarely share a
+// cache line. No shard ever holds more than its initial share, so the
+// shards never hold more than N permits between them. A separate count of
+// the permits in use, also over Interval<0, N>, is decremented first on
+// release, so an over-release is refused whole with nothing changed. Once
+// that succeeds the shards have room for the permits in total, and they
+// go to the releasing thread's shard, spilling into the others when it is
+// full. A request for more permits than any single shard holds can fail
+// even though enough permits remain in total, and available() sums the
+// shards one at a time, so under concurrent updates it is an estimate
+// (still within [0, N]).
+
+#ifndef REFINERY_COUNTER_HPP
+#define REFINERY_COUNTER_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <variant>
+
+#include "atomic.hpp"
+#include "interval.hpp"
+
+namespace refinery {
+
+namespace detail {
+
+inline constexpr std::size_t cache_line_size = 64;
+
+// Small per-thread number used to spread threads over shards
+inline std::size_t thread_slot() noexcept {
+    static std::atomic<std::size_t> next{0};
+    thread_local const std::size_t slot =
+        next.fetch_add(1, std::memory_order::relaxed);
+    return slot;
+}
+
+} // namespace detail
+
+template <std::size_t N, std::size_t Shards = 1>
+    requires(N > 0 && Shards > 0)
+class BoundedCounter {
+  public:
+    using count_type = IntervalRefined<std::size_t, std::size_t{0}, N>;
+
+    static constexpr std::size_t capacity = N;
+    static constexpr std::size_t shard_count = Shards;
+
+  private:
+    struct alignas(detail::cache_line_size) shard {
+        AtomicRefined<std::size_t, count_type::predicate> available{
+            count_type{0}};
+    };
+
+    std::array<shard, Shards> shards_;
+
+    // Permits acquired and not yet released; only kept when sharded, where
+    // the shards alone cannot tell an over-release from a full shard
+    struct alignas(detail::cache_line_size) usage {
+        AtomicRefined<std::size_t, count_type::predicate> in_use{
+            count_type{0}};
+    };
+    [[no_unique_address]] std::conditional_t<(Shards > 1), usage,
+                                             std::monostate> usage_;
+
+    // Permits shard i starts with, and the most it may hold
+    static constexpr std::size_t share(std::size_t i) noexcept {
+        return N / Shards + (i < N % Shards ? 1 : 0);
+    }
+
+    std::size_t home() const noexcept {
+        if constexpr (Shards == 1)
+            return 0;
+        else
+            return detail::thread_slot() % Shards;
+    }
+
+  public:
+    // All N permits available, spread evenly over the shards
+    BoundedCounter() noexcept {
+        for (std::size_t i = 0; i < Shards; ++i)
+            shards_[i].available.store(count_type(share(i), assume_valid),
+                                       std::memory_order::relaxed);
+    }
+
+    BoundedCounter(const BoundedCounter&) = delete;
+    BoundedCounter& operator=(const BoundedCounter&) = delete;
+
+    // Take k permits. Returns the permits left in the shard that supplied
+    // them (all remaining permits when unsharded), or nullopt if none could.
+    std::optional<count_type> try_acquire(std::size_t k = 1) noexcept {
+        const std::size_t first = home();
+        for (std::size_t i = 0; i < Shards; ++i) {
+            auto& counter = shards_[(first + i) % Shards].available;
+            if (auto before =
+                    counter.fetch_sub(k, std::memory_order::acquire)) {
+                // The k permits left the shards, so in_use has room for
+                // them: shards and in_use never sum to more than N
+                if constexpr (Shards > 1)
+                    (void)usage_.in_use.fetch_add(k,
+                                                  std::memory_order::relaxed);
+                return count_type(before->get() - k, assume_valid);
+            }
+        }
+        return std::nullopt;
+    }
+
+    // Return k permits. Returns false, changing nothing, if k exceeds the
+    // permits in use.
+    bool release(std::size_t k = 1) noexcept {
+        if constexpr (Shards == 1) {
+            return shards_[0]
+                .available.fetch_add(k, std::memory_order::release)
+                .has_value();
+        } else {
+            if (!usage_.in_use.fetch_sub(k, std::memory_order::relaxed))
+                return false;
+            // The shards now have room for k in total, though a pass can
+            // miss it while other threads move permits between shards
+            const std::size_t first = home();
+            std::size_t left = k;
+            while (left > 0) {
+                for (std::size_t i = 0; i < Shards && left > 0; ++i) {
+                    const std::size_t index = (first + i) % Shards;
+                    std::size_t moved = 0;
+                    auto before = shards_[index].available.fetch_update(
+                        [&](std::size_t v) -> std::optional<std::size_t> {
+                            moved = std::min(left, share(index) - v);
+                            if (moved == 0)
+                                return std::nullopt;
+                            return v + moved;
+                        },
+                        std::memory_order::release);
+                    if (before)
+                        left -= moved;
+                }
+            }
+            return true;
+        }
+    }
+
+    // No shard holds more than its share, so the sum never exceeds N
+    [[nodiscard]] count_type available() const noexcept {
+        std::size_t total = 0;
+        for (const shard& s : shards_)
+            total += s.available.load(std::memory_order::relaxed).get();
+        return count_type(total, assume_valid);
+    }
+
+    [[nodiscard]] count_type in_use() const noexcept {
+        if constexpr (Shards == 1)
+            return count_type(N - available().get(), assume_valid);
+        else
+            return usage_.in_use.load(std::memory_order::relaxed);
+    }
+};
+
+} // namespace refinery
+
+#endif // REFINERY_COUNTER_HPP
@@ -0,0 +1,179 @@
+// decode.hpp - Validating decoder for fixed-layout binary records
+// Part of the C++26 Refinement Types Library
+//
+// decode<S, Order>(bytes) reads the members of S from a packed byte buffer
+// (declaration order, no padding, little or big endian) and checks each one
+// as it is loaded, so the bytes are touched once instead of once to decode
+// and again to validate:
+//
+//   struct Header {
+//       IntervalRefined<std::uint8_t, 1, 4> version;
+//       PortNumber<std::uint16_t> port;
+//       [[=check<Positive>]] std::uint32_t length;
+//   };
+//   static_assert(wire_size_v<Header> == 7);
+//
+//   auto header = decode<Header, std::endian::big>(packet);
+//   if (!header)
+//       log(header.error().field);   // "port", ...
+//
+// Members may be arithmetic types, enums, or Refined wrappers of those, and
+// are checked with the same rules as Valid<S> from reflect.hpp. A Refined
+// member is tested against its predicate on the raw value and only then
+// constructed with assume_valid. Each member is copied straight from the
+// buffer to its final position in the result, so no intermediate record is
+// built; when the wire and native layouts coincide the copies merge into
+// one block move.
+//
+// The first failing member is reported; checking stops there.
+
+#ifndef REFINERY_DECODE_HPP
+#define REFINERY_DECODE_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+#include <meta>
+
+#include "bytes.hpp"
+#include "reflect.hpp"
+
+namespace refinery {
+
+// Why decode rejected its input
+struct decode_error {
+    enum class kind {
+        truncated,              // buffer shorter than wire_size_v<S>
+        invalid_representation, // bytes that are not a value of the type
+        predicate_failed,       // a member failed its checks
+    };
+
+    kind reason;
+    std::string_view field; // empty when truncated
+    std::size_t offset;     // wire offset of the field, or the buffer size
+};
+
+namespace detail {
+
+template <typename F> struct wire_value {
+    using type = F;
+};
+
+template <typename F>
+    requires is_refined<F>
+struct wire_value<F> {
+    using type = typename F::value_type;
+};
+
+// The type a member is stored as on the wire: T for Refined<T, P>
+template <typename F> using wire_value_t = typename wire_value<F>::type;
+
+template <typename T>
+concept wire_scalar = byte_scalar<T>;
+
+template <typename S> consteval bool wire_layout() {
+    if (!std::is_trivially_copyable_v<S>)
+        return false;
+    bool ok = true;
+    template for (constexpr std::meta::info m : fields_of<S>()) {
+        ok = ok && !std::meta::is_bit_field(m) &&
+             wire_scalar<wire_value_t<field_type<m>>>;
+    }
+    return ok;
+}
+
+template <typename S> consteval std::size_t wire_size() {
+    std::size_t size = 0;
+    template for (constexpr std::meta::info m : fields_of<S>()) {
+        size += sizeof(wire_value_t<field_type<m>>);
+    }
+    return size;
+}
+
+} // namespace detail
+
+// Records decode can read: trivially copyable aggregates whose members are
+// arithmetic, enums, or Refined wrappers of those
+template <typename S>
+concept wire_record = std::is_class_v<S> && !is_refined<S> &&
+                      (detail::wire_layout<S>());
+
+// Number of bytes decode<S> consumes
+template <wire_record S>
+inline constexpr std::size_t wire_size_v = detail::wire_size<S>();
+
+namespace detail {
+
+// Decode one S from bytes, which hold at least wire_size_v<S>. With Check
+// false nothing is validated: members are rebuilt with assume_valid, for
+// input from a source that has already checked them.
+template <typename S, std::endian Order, bool Check>
+std::expected<S, decode_error>
+decode_record(std::span<const std::byte> bytes) noexcept {
+    using enum decode_error::kind;
+    std::array<std::byte, sizeof(S)> image{};
+    const std::byte* in = bytes.data();
+    std::size_t offset = 0;
+    template for (constexpr std::meta::info m : fields_of<S>()) {
+        using F = field_type<m>;
+        using W = wire_value_t<F>;
+        constexpr std::string_view name = std::meta::identifier_of(m);
+        constexpr std::size_t dest = std::meta::offset_of(m).bytes;
+
+        W value;
+        if constexpr (std::is_same_v<W, bool>) {
+            auto byte = std::to_integer<unsigned char>(in[offset]);
+            if (Check && byte > 1)
+                return std::unexpected(
+                    decode_error{invalid_representation, name, offset});
+            value = byte != 0;
+        } else {
+            value = load_scalar<W, Order>(in + offset);
+        }
+
+        if constexpr (Check && is_refined<F>) {
+            if (!F::predicate(value))
+                return std::unexpected(
+                    decode_error{predicate_failed, name, offset});
+        }
+        const F field = [&] {
+            if constexpr (is_refined<F>)
+                return F(value, assume_valid);
+            else
+                return value;
+        }();
+        if constexpr (Check) {
+            if (!check_annotations<m>(field))
+                return std::unexpected(
+                    decode_error{predicate_failed, name, offset});
+        }
+
+        std::memcpy(image.data() + dest, &field, sizeof(F));
+        offset += sizeof(W);
+    }
+    return std::bit_cast<S>(image);
+}
+
+} // namespace detail
+
+// Decode and validate one S from the front of bytes. Trailing bytes past
+// wire_size_v<S> are ignored.
+template <wire_record S, std::endian Order = std::endian::little>
+[[nodiscard]] std::expected<S, decode_error>
+decode(std::span<const std::byte> bytes) noexcept {
+    if (bytes.size() < wire_size_v<S>)
+        return std::unexpected(
+            decode_error{decode_error::kind::truncated, {}, bytes.size()});
+    return detail::decode_record<S, Order, true>(bytes);
+}
+
+} // namespace refinery
+
+#endif // REFINERY_DECODE_HPP
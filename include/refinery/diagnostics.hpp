@@ -4,11 +4,13 @@
 #ifndef REFINERY_DIAGNOSTICS_HPP
 #define REFINERY_DIAGNOSTICS_HPP
 
+#include <concepts>
 #include <exception>
 #include <format>
 #include <source_location>
 #include <string>
 #include <string_view>
+#include <type_traits>
 
 #include <meta>
 
@@ -16,11 +18,24 @@ namespace refinery {
 
 namespace detail {
 
-// Format a value for diagnostic output using reflection
+// Format a value for diagnostic output using reflection. String-like values
+// are quoted directly; other class types may not be structural, so they are
+// described by their type.
 template <typename T> consteval std::string format_value(const T& value) {
     using namespace std::meta;
-    auto refl = reflect_constant(value);
-    return std::string(display_string_of(refl));
+    if constexpr (std::convertible_to<const T&, std::string_view>) {
+        std::string out = "\"";
+        out += std::string_view(value);
+        out += '"';
+        return out;
+    } else if constexpr (std::is_class_v<T> || std::is_union_v<T>) {
+        std::string out = "value of type ";
+        out += display_string_of(^^T);
+        return out;
+    } else {
+        auto refl = reflect_constant(value);
+        return std::string(display_string_of(refl));
+    }
 }
 
 // Build error message using reflection
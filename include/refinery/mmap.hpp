@@ -0,0 +1,268 @@
+// mmap.hpp - Validated read-only views of memory-mapped arrays
+// Part of the C++26 Refinement Types Library
+//
+// MappedArray<R> maps a file holding a packed array of R::value_type in
+// native byte order, checks every element against R's predicate, and on
+// success exposes the mapping itself as std::span<const R>:
+//
+//   WorkStealingPool pool;
+//   auto prices = MappedArray<PositiveF64>::open("prices.f64", pool);
+//   if (!prices)
+//       return report(prices.error());   // I/O, size, or first bad index
+//   for (PositiveF64 p : prices->values())
+//       ...
+//
+// Nothing is copied: the view points into the kernel's page cache, and
+// pages are only read in as the validation pass (or later use) touches
+// them. The file is scanned in 2 MiB chunks, a multiple of both the base
+// and the huge page size, spread over the pool's threads. The mapping is
+// advised MADV_SEQUENTIAL (and MADV_HUGEPAGE where supported) for the scan
+// and MADV_NORMAL (and MADV_NOHUGEPAGE) afterwards, so later random access
+// is not read ahead and huge pages are not collapsed for it.
+//
+// The file must not be modified while mapped; the checks only hold for
+// the contents seen during the scan.
+
+#ifndef REFINERY_MMAP_HPP
+#define REFINERY_MMAP_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <span>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<sys/mman.h>)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define REFINERY_HAS_MMAP 1
+#endif
+
+#include "bulk.hpp"
+#include "parallel.hpp"
+#include "refined_type.hpp"
+
+namespace refinery {
+
+#if defined(REFINERY_HAS_MMAP)
+
+// Why MappedArray::open failed. `code` is set for io, `index` (the first
+// element that failed the predicate) for predicate_failed.
+struct mapped_array_error {
+    enum class kind { io, bad_size, predicate_failed };
+    kind reason;
+    std::error_code code;
+    std::size_t index;
+};
+
+// Refined types whose arrays can be viewed in place: the wrapper must have
+// exactly the layout of its trivially copyable value
+template <typename R>
+concept mappable_refined =
+    is_refined<R> && std::is_trivially_copyable_v<typename R::value_type> &&
+    std::is_trivially_copyable_v<R> && std::is_standard_layout_v<R> &&
+    sizeof(R) == sizeof(typename R::value_type) &&
+    alignof(R) == alignof(typename R::value_type);
+
+namespace detail {
+
+// Read-only private mapping of a whole file, unmapped on destruction
+class file_mapping {
+    void* base_ = nullptr;
+    std::size_t bytes_ = 0;
+
+    file_mapping(void* base, std::size_t bytes) noexcept
+        : base_(base), bytes_(bytes) {}
+
+    static std::error_code last_error() noexcept {
+        return {errno, std::system_category()};
+    }
+
+  public:
+    file_mapping() noexcept = default;
+
+    static std::expected<file_mapping, std::error_code>
+    open(const std::filesystem::path& path) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return std::unexpected(last_error());
+        struct stat st{};
+        if (::fstat(fd, &st) != 0) {
+            auto ec = last_error();
+            ::close(fd);
+            return std::unexpected(ec);
+        }
+        const auto bytes = static_cast<std::size_t>(st.st_size);
+        if (bytes == 0) {
+            ::close(fd);
+            return file_mapping();
+        }
+        void* base = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED)
+            return std::unexpected(last_error());
+        return file_mapping(base, bytes);
+    }
+
+    file_mapping(file_mapping&& other) noexcept
+        : base_(std::exchange(other.base_, nullptr)),
+          bytes_(std::exchange(other.bytes_, 0)) {}
+    file_mapping& operator=(file_mapping&& other) noexcept {
+        std::swap(base_, other.base_);
+        std::swap(bytes_, other.bytes_);
+        return *this;
+    }
+    file_mapping(const file_mapping&) = delete;
+    file_mapping& operator=(const file_mapping&) = delete;
+
+    ~file_mapping() {
+        if (base_)
+            ::munmap(base_, bytes_);
+    }
+
+    [[nodiscard]] std::span<const std::byte> bytes() const noexcept {
+        return {static_cast<const std::byte*>(base_), bytes_};
+    }
+
+    // Access-pattern hint; failures are harmless and ignored
+    void advise(int advice) const noexcept {
+        if (base_)
+            ::madvise(base_, bytes_, advice);
+    }
+
+    void advise_sequential_scan() const noexcept {
+        advise(MADV_SEQUENTIAL);
+#if defined(MADV_HUGEPAGE)
+        advise(MADV_HUGEPAGE);
+#endif
+    }
+
+    // Undo advise_sequential_scan. MADV_NORMAL only resets read-ahead, so
+    // the huge page hint is withdrawn separately.
+    void end_sequential_scan() const noexcept {
+        advise(MADV_NORMAL);
+#if defined(MADV_NOHUGEPAGE)
+        advise(MADV_NOHUGEPAGE);
+#endif
+    }
+};
+
+// Bytes per parallel validation chunk: whole base and huge pages
+inline constexpr std::size_t mapped_chunk_bytes = std::size_t{2} << 20;
+
+// Index of the first value failing Pred, or values.size(). Chunks after
+// the earliest failure found so far are skipped, but earlier ones still
+// run, so the index is exact.
+template <auto Pred, typename T>
+std::size_t first_failing(WorkStealingPool& pool,
+                          std::span<const T> values) {
+    constexpr std::size_t per_chunk =
+        std::max<std::size_t>(1, mapped_chunk_bytes / sizeof(T));
+    if (pool.size() == 1 || values.size() <= per_chunk)
+        return bulk::first_failing<Pred>(values);
+    std::atomic<std::size_t> first{values.size()};
+    const std::size_t chunks = (values.size() + per_chunk - 1) / per_chunk;
+    pool.for_each_chunk(chunks, [&](std::size_t c) {
+        const std::size_t begin = c * per_chunk;
+        if (begin >= first.load(std::memory_order::relaxed))
+            return true;
+        auto slice =
+            values.subspan(begin, std::min(per_chunk, values.size() - begin));
+        std::size_t bad = bulk::first_failing<Pred>(slice);
+        if (bad != slice.size()) {
+            std::size_t index = begin + bad;
+            std::size_t seen = first.load(std::memory_order::relaxed);
+            while (index < seen &&
+                   !first.compare_exchange_weak(seen, index,
+                                                std::memory_order::relaxed))
+                ;
+        }
+        return true;
+    });
+    return first.load(std::memory_order::relaxed);
+}
+
+} // namespace detail
+
+template <mappable_refined R> class MappedArray {
+    using T = typename R::value_type;
+
+    detail::file_mapping mapping_;
+    std::span<const R> values_;
+
+    MappedArray(detail::file_mapping mapping, std::span<const R> values)
+        : mapping_(std::move(mapping)), values_(values) {}
+
+    static std::expected<MappedArray, mapped_array_error>
+    map(const std::filesystem::path& path, WorkStealingPool* pool) {
+        auto mapping = detail::file_mapping::open(path);
+        if (!mapping) {
+            return std::unexpected(mapped_array_error{
+                mapped_array_error::kind::io, mapping.error(), 0});
+        }
+        const std::span<const std::byte> bytes = mapping->bytes();
+        if (bytes.size() % sizeof(T) != 0) {
+            return std::unexpected(mapped_array_error{
+                mapped_array_error::kind::bad_size, {}, 0});
+        }
+        // Page-aligned, so suitably aligned for T
+        const std::span<const T> raw(
+            reinterpret_cast<const T*>(bytes.data()),
+            bytes.size() / sizeof(T));
+
+        mapping->advise_sequential_scan();
+        const std::size_t bad =
+            pool ? detail::first_failing<R::predicate>(*pool, raw)
+                 : detail::bulk::first_failing<R::predicate>(raw);
+        mapping->end_sequential_scan();
+        if (bad != raw.size()) {
+            return std::unexpected(mapped_array_error{
+                mapped_array_error::kind::predicate_failed, {}, bad});
+        }
+        const std::span<const R> values(
+            reinterpret_cast<const R*>(raw.data()), raw.size());
+        return MappedArray(std::move(*mapping), values);
+    }
+
+  public:
+    using value_type = R;
+
+    // Map and validate on the calling thread
+    static std::expected<MappedArray, mapped_array_error>
+    open(const std::filesystem::path& path) {
+        return map(path, nullptr);
+    }
+
+    // Map and validate across the pool's threads
+    static std::expected<MappedArray, mapped_array_error>
+    open(const std::filesystem::path& path, WorkStealingPool& pool) {
+        return map(path, &pool);
+    }
+
+    MappedArray(MappedArray&&) noexcept = default;
+    MappedArray& operator=(MappedArray&&) noexcept = default;
+
+    [[nodiscard]] std::span<const R> values() const noexcept {
+        return values_;
+    }
+    [[nodiscard]] std::size_t size() const noexcept { return values_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return values_.empty(); }
+    [[nodiscard]] const R& operator[](std::size_t i) const noexcept {
+        return values_[i];
+    }
+    [[nodiscard]] auto begin() const noexcept { return values_.begin(); }
+    [[nodiscard]] auto end() const noexcept { return values_.end(); }
+};
+
+#endif // REFINERY_HAS_MMAP
+
+} // namespace refinery
+
+#endif // REFINERY_MMAP_HPP
@@ -0,0 +1,228 @@
+// packed.hpp - Bit-packed records of interval-refined members
+// Part of the C++26 Refinement Types Library
+//
+// Packed<Record> stores a record whose members are interval-refined integers
+// or booleans in as few bits as their bounds allow, laid out at compile time
+// by reflecting over Record:
+//
+//   struct Entry {
+//       IntervalRefined<int, 0, 100> score;     //  7 bits
+//       IntervalRefined<int, 0, 7> level;       //  3 bits
+//       Refined<bool, Always> active;           //  1 bit
+//       PortNumber<> port;                      // 16 bits
+//   };
+//   static_assert(sizeof(Packed<Entry>) == 4);  // sizeof(Entry) == 16
+//
+//   Packed<Entry> p(entry);
+//   PortNumber<> port = p.get<&Entry::port>();
+//   p.set<&Entry::level>(IntervalRefined<int, 0, 7>{5});
+//
+// An integer refined by Interval<Lo, Hi> is stored as its offset from Lo in
+// bit_width(Hi - Lo) bits. Fields are placed in declaration order and never
+// straddle a word; a record of up to 64 bits is held in the narrowest
+// unsigned integer that fits it. Setters take the member's refined type, so
+// every stored code decodes to a valid value and no runtime check is needed
+// in either direction.
+
+#ifndef REFINERY_PACKED_HPP
+#define REFINERY_PACKED_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include <meta>
+
+#include "reflect.hpp"
+
+namespace refinery {
+
+namespace detail {
+
+// How a member of type F is coded in bits; only specialized for packable F
+template <typename F> struct bit_codec;
+
+template <typename F>
+    requires is_refined<F> &&
+             coded_integral<typename F::value_type, F::predicate>
+struct bit_codec<F> {
+    using code = interval_code<typename F::value_type, F::predicate>;
+    static constexpr unsigned bits = code::bits;
+
+    static constexpr std::uint64_t encode(const F& f) noexcept {
+        return code::encode(f.get());
+    }
+    static constexpr F decode(std::uint64_t c) noexcept {
+        using S = typename code::storage_type;
+        return F(code::decode(static_cast<S>(c)), assume_valid);
+    }
+};
+
+template <> struct bit_codec<bool> {
+    static constexpr unsigned bits = 1;
+
+    static constexpr std::uint64_t encode(bool b) noexcept { return b; }
+    static constexpr bool decode(std::uint64_t c) noexcept { return c != 0; }
+};
+
+template <typename F>
+    requires is_refined<F> && std::same_as<typename F::value_type, bool>
+struct bit_codec<F> {
+    static constexpr unsigned bits = 1;
+
+    static constexpr std::uint64_t encode(const F& f) noexcept {
+        return f.get();
+    }
+    static constexpr F decode(std::uint64_t c) noexcept {
+        return F(c != 0, assume_valid);
+    }
+};
+
+template <typename F>
+concept bit_packable = requires { bit_codec<F>::bits; };
+
+template <typename S> consteval bool all_bit_packable() {
+    bool ok = fields_of<S>().size() > 0;
+    template for (constexpr std::meta::info m : fields_of<S>()) {
+        ok = ok && !std::meta::is_bit_field(m) &&
+             bit_packable<field_type<m>>;
+    }
+    return ok;
+}
+
+// Position of one member: bits [shift, shift + bits) of word `word`
+struct bit_slot {
+    std::size_t word;
+    unsigned shift;
+    unsigned bits;
+};
+
+// Greedy placement in declaration order, starting a new 64-bit word when a
+// field does not fit in the rest of the current one
+template <typename S> consteval auto bit_layout() {
+    std::array<bit_slot, fields_of<S>().size()> slots{};
+    std::size_t word = 0;
+    unsigned used = 0;
+    std::size_t i = 0;
+    template for (constexpr std::meta::info m : fields_of<S>()) {
+        constexpr unsigned bits = bit_codec<field_type<m>>::bits;
+        if (used + bits > 64) {
+            ++word;
+            used = 0;
+        }
+        slots[i++] = bit_slot{word, used, bits};
+        used += bits;
+    }
+    return slots;
+}
+
+constexpr std::uint64_t low_bits(unsigned n) noexcept {
+    return n >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << n) - 1;
+}
+
+} // namespace detail
+
+// Records Packed can hold: aggregates whose members are all integers refined
+// by an integral Interval, bool, or Refined<bool, P>
+template <typename S>
+concept bit_packable_record = std::is_class_v<S> && std::is_aggregate_v<S> &&
+                              !is_refined<S> &&
+                              (detail::all_bit_packable<S>());
+
+template <bit_packable_record Record> class Packed {
+    static constexpr auto fields = detail::fields_of<Record>();
+    static constexpr auto layout = detail::bit_layout<Record>();
+
+  public:
+    // Bits in use, counting the unused tail of every word but the last
+    static constexpr std::size_t bits_used =
+        layout.back().word * 64 + layout.back().shift + layout.back().bits;
+    static constexpr std::size_t word_count = layout.back().word + 1;
+
+    using word_type = std::conditional_t<
+        (bits_used <= 8), std::uint8_t,
+        std::conditional_t<
+            (bits_used <= 16), std::uint16_t,
+            std::conditional_t<(bits_used <= 32), std::uint32_t,
+                               std::uint64_t>>>;
+    using record_type = Record;
+
+  private:
+    template <auto Member>
+        requires(detail::member_index<Record, Member>() < fields.size())
+    static constexpr std::size_t index_of =
+        detail::member_index<Record, Member>();
+
+    template <std::size_t I> using field_t = detail::field_type<fields[I]>;
+
+    std::array<word_type, word_count> words_{};
+
+    template <std::size_t I> constexpr field_t<I> load() const noexcept {
+        constexpr detail::bit_slot slot = layout[I];
+        if constexpr (slot.bits == 0) {
+            return detail::bit_codec<field_t<I>>::decode(0);
+        } else {
+            const std::uint64_t word = words_[slot.word];
+            return detail::bit_codec<field_t<I>>::decode(
+                (word >> slot.shift) & detail::low_bits(slot.bits));
+        }
+    }
+
+    template <std::size_t I>
+    constexpr void store(const field_t<I>& value) noexcept {
+        constexpr detail::bit_slot slot = layout[I];
+        if constexpr (slot.bits > 0) {
+            constexpr std::uint64_t mask = detail::low_bits(slot.bits)
+                                           << slot.shift;
+            // Masked, so a value outside the field's interval (made with
+            // assume_valid) cannot spill into its neighbours
+            const std::uint64_t code =
+                (detail::bit_codec<field_t<I>>::encode(value) &
+                 detail::low_bits(slot.bits))
+                << slot.shift;
+            words_[slot.word] = static_cast<word_type>(
+                (words_[slot.word] & ~mask) | code);
+        }
+    }
+
+    template <std::size_t... I>
+    constexpr void store_all(const Record& r,
+                             std::index_sequence<I...>) noexcept {
+        (store<I>(r.[:fields[I]:]), ...);
+    }
+
+    template <std::size_t... I>
+    constexpr Record load_all(std::index_sequence<I...>) const noexcept {
+        return Record{load<I>()...};
+    }
+
+  public:
+    constexpr explicit Packed(const Record& r) noexcept {
+        store_all(r, std::make_index_sequence<fields.size()>{});
+    }
+
+    [[nodiscard]] constexpr Record unpack() const noexcept {
+        return load_all(std::make_index_sequence<fields.size()>{});
+    }
+
+    template <auto Member>
+    [[nodiscard]] constexpr auto get() const noexcept {
+        return load<index_of<Member>>();
+    }
+
+    // The value is already refined, so the setter never checks
+    template <auto Member>
+    constexpr void set(const field_t<index_of<Member>>& value) noexcept {
+        store<index_of<Member>>(value);
+    }
+
+    // Unused bits are always zero, so equal records have equal words
+    [[nodiscard]] friend constexpr bool operator==(const Packed&,
+                                                   const Packed&) = default;
+};
+
+} // namespace refinery
+
+#endif // REFINERY_PACKED_HPP
@@ -0,0 +1,196 @@
+// parallel.hpp - Small work-stealing thread pool for bulk validation
+// Part of the C++26 Refinement Types Library
+//
+// WorkStealingPool runs a body over the chunks [0, n) of a job on a fixed
+// set of threads, with the calling thread taking part:
+//
+//   WorkStealingPool pool;                 // one thread per core
+//   bool all_ran = pool.for_each_chunk(chunks, [&](std::size_t c) {
+//       return check(slice(c));            // false cancels the rest
+//   });
+//
+// Each participant starts with an equal, contiguous share of the chunks and
+// takes them from the front of its share. One that runs out steals the back
+// half of another's remaining share, so uneven chunks (an early failure,
+// a slow predicate on part of the input) still keep every core busy. A
+// share is a pair of 32-bit chunk indices in one atomic word, updated by
+// compare-and-swap from both ends; there are no locks on the hot path.
+//
+// Returning false from the body cancels the chunks not yet started, for
+// yes/no questions that are settled by the first failure. Jobs from
+// different threads are serialized; the body must not throw and must not
+// start another job on the same pool.
+
+#ifndef REFINERY_PARALLEL_HPP
+#define REFINERY_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "counter.hpp"
+
+namespace refinery {
+
+class WorkStealingPool {
+  public:
+    // Most chunks a single job can have
+    static constexpr std::size_t max_chunks =
+        std::numeric_limits<std::uint32_t>::max();
+
+    // A pool of `threads` participants: the caller plus threads - 1 workers
+    explicit WorkStealingPool(
+        std::size_t threads = std::max(1u, std::thread::hardware_concurrency()))
+        : size_(std::max<std::size_t>(threads, 1)),
+          shares_(std::make_unique<share[]>(size_)) {
+        workers_.reserve(size_ - 1);
+        for (std::size_t i = 1; i < size_; ++i)
+            workers_.emplace_back([this, i] { work(i); });
+    }
+
+    ~WorkStealingPool() {
+        stopping_.store(true, std::memory_order::relaxed);
+        epoch_.fetch_add(1, std::memory_order::release);
+        epoch_.notify_all();
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    // Run body(c) once for every chunk c in [0, chunks), unless a call
+    // returns false, after which chunks not yet started are skipped.
+    // Returns true if every chunk ran and none returned false. Requires
+    // chunks <= max_chunks.
+    template <typename F>
+        requires std::is_invocable_r_v<bool, F&, std::size_t>
+    bool for_each_chunk(std::size_t chunks, F body) {
+        if (chunks == 0)
+            return true;
+        std::scoped_lock lock(run_mutex_);
+        for (std::size_t i = 0; i < size_; ++i) {
+            shares_[i].range.store(pack(chunks * i / size_,
+                                        chunks * (i + 1) / size_),
+                                   std::memory_order::relaxed);
+        }
+        job_ = &body;
+        run_ = [](void* job, std::size_t chunk) -> bool {
+            return std::invoke(*static_cast<F*>(job), chunk);
+        };
+        cancelled_.store(false, std::memory_order::relaxed);
+        active_.store(size_ - 1, std::memory_order::relaxed);
+        epoch_.fetch_add(1, std::memory_order::release);
+        epoch_.notify_all();
+
+        participate(0);
+        for (std::size_t left; (left = active_.load(
+                                    std::memory_order::acquire)) != 0;)
+            active_.wait(left, std::memory_order::acquire);
+        return !cancelled_.load(std::memory_order::relaxed);
+    }
+
+  private:
+    // Remaining chunks [begin, end) of one participant: begin in the high
+    // half, end in the low half
+    struct alignas(detail::cache_line_size) share {
+        std::atomic<std::uint64_t> range{0};
+    };
+
+    static constexpr std::uint64_t pack(std::uint64_t begin,
+                                        std::uint64_t end) noexcept {
+        return (begin << 32) | end;
+    }
+    static constexpr std::uint64_t begin_of(std::uint64_t r) noexcept {
+        return r >> 32;
+    }
+    static constexpr std::uint64_t end_of(std::uint64_t r) noexcept {
+        return r & 0xffff'ffff;
+    }
+
+    std::size_t size_;
+    std::unique_ptr<share[]> shares_;
+    std::mutex run_mutex_;
+    void* job_ = nullptr;
+    bool (*run_)(void*, std::size_t) = nullptr;
+    std::atomic<bool> cancelled_{false};
+    std::atomic<bool> stopping_{false};
+    std::atomic<std::uint64_t> epoch_{0};
+    std::atomic<std::size_t> active_{0};
+    // Last member, so the workers are joined before anything above goes
+    std::vector<std::jthread> workers_;
+
+    // Next chunk from the front of our own share
+    std::optional<std::size_t> take(std::size_t self) noexcept {
+        auto& range = shares_[self].range;
+        std::uint64_t r = range.load(std::memory_order::relaxed);
+        while (begin_of(r) < end_of(r)) {
+            if (range.compare_exchange_weak(r,
+                                            pack(begin_of(r) + 1, end_of(r)),
+                                            std::memory_order::relaxed))
+                return begin_of(r);
+        }
+        return std::nullopt;
+    }
+
+    // Move the back half of another participant's share into ours and
+    // return its first chunk. Shares only ever split, never merge, so a
+    // range value cannot reappear and the CAS is free of ABA.
+    std::optional<std::size_t> steal(std::size_t self) noexcept {
+        for (std::size_t i = 1; i < size_; ++i) {
+            auto& range = shares_[(self + i) % size_].range;
+            std::uint64_t r = range.load(std::memory_order::relaxed);
+            while (begin_of(r) < end_of(r)) {
+                std::uint64_t half = (end_of(r) - begin_of(r) + 1) / 2;
+                std::uint64_t first = end_of(r) - half;
+                if (range.compare_exchange_weak(r,
+                                                pack(begin_of(r), first),
+                                                std::memory_order::relaxed)) {
+                    // Our share is empty, so no thief will touch it
+                    shares_[self].range.store(pack(first + 1, end_of(r)),
+                                              std::memory_order::relaxed);
+                    return first;
+                }
+            }
+        }
+        return std::nullopt;
+    }
+
+    void participate(std::size_t self) noexcept {
+        while (!cancelled_.load(std::memory_order::relaxed)) {
+            std::optional<std::size_t> chunk = take(self);
+            if (!chunk)
+                chunk = steal(self);
+            if (!chunk)
+                return;
+            if (!run_(job_, *chunk))
+                cancelled_.store(true, std::memory_order::relaxed);
+        }
+    }
+
+    void work(std::size_t self) noexcept {
+        std::uint64_t seen = 0;
+        for (;;) {
+            epoch_.wait(seen, std::memory_order::acquire);
+            seen = epoch_.load(std::memory_order::acquire);
+            if (stopping_.load(std::memory_order::relaxed))
+                return;
+            participate(self);
+            if (active_.fetch_sub(1, std::memory_order::acq_rel) == 1)
+                active_.notify_all();
+        }
+    }
+};
+
+} // namespace refinery
+
+#endif // REFINERY_PARALLEL_HPP
@@ -128,6 +128,26 @@ inline constexpr auto SizeInRange = [](std::size_t min_size,
     };
 };
 
+namespace detail {
+
+// Stand-in container for evaluating size predicates at compile time
+struct sized {
+    std::size_t n;
+    constexpr std::size_t size() const noexcept { return n; }
+    constexpr bool empty() const noexcept { return n == 0; }
+};
+
+// Pred is SizeAtLeast, SizeAtMost, SizeInRange or SizeExactly for some
+// bounds, so it depends on size() alone and admits an interval of sizes
+template <auto Pred, typename P = std::remove_cv_t<decltype(Pred)>>
+concept size_interval_predicate =
+    std::same_as<P, decltype(SizeAtLeast(0))> ||
+    std::same_as<P, decltype(SizeAtMost(0))> ||
+    std::same_as<P, decltype(SizeInRange(0, 0))> ||
+    std::same_as<P, decltype(SizeExactly(0))>;
+
+} // namespace detail
+
 // --- Pointer predicates ---
 
 // True if pointer is null
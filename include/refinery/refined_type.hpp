@@ -4,11 +4,19 @@
 #ifndef REFINERY_REFINED_TYPE_HPP
 #define REFINERY_REFINED_TYPE_HPP
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <format>
 #include <functional>
+#include <limits>
 #include <optional>
+#include <source_location>
 #include <stdexcept>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 
@@ -31,6 +39,37 @@ concept has_interval_bounds = requires {
     { decltype(Pred)::hi };
 };
 
+// Detect alignment predicates (e.g. Aligned<N>) without depending on
+// aligned.hpp
+template <auto Pred>
+concept has_alignment = requires {
+    { decltype(Pred)::alignment };
+};
+
+// Detect size-multiple predicates (e.g. SizeDivisibleBy<N>) without
+// depending on span.hpp
+template <auto Pred>
+concept has_size_multiple = requires {
+    { decltype(Pred)::multiple };
+};
+
+// Detect exact-size predicates (e.g. FixedSize<N>)
+template <auto Pred>
+concept has_exact_size = requires {
+    { decltype(Pred)::exact };
+};
+
+// Detect adaptor predicates (e.g. Tabulated<P, T>) that accept exactly the
+// same values as the predicate they wrap
+template <auto Pred>
+concept has_underlying_predicate = requires {
+    { decltype(Pred)::underlying };
+};
+
+// Template-argument equivalence of two predicate values
+template <auto A, auto B> struct same_predicate_value : std::false_type {};
+template <auto A> struct same_predicate_value<A, A> : std::true_type {};
+
 } // namespace detail
 
 // Implication traits for predicate conversions (base template)
@@ -47,9 +86,23 @@ namespace detail {
 
 template <typename T, auto Source, auto Target>
 consteval bool predicate_implies() {
-    if constexpr (has_interval_bounds<Source> && has_interval_bounds<Target>) {
+    if constexpr (same_predicate_value<Source, Target>::value) {
+        return true;
+    } else if constexpr (has_underlying_predicate<Source>) {
+        // Adaptors are equivalent to their underlying predicate
+        return predicate_implies<T, decltype(Source)::underlying, Target>();
+    } else if constexpr (has_underlying_predicate<Target>) {
+        return predicate_implies<T, Source, decltype(Target)::underlying>();
+    } else if constexpr (has_interval_bounds<Source> &&
+                         has_interval_bounds<Target>) {
         // Interval -> Interval: source must be a subset of target
         return Source.lo >= Target.lo && Source.hi <= Target.hi;
+    } else if constexpr (has_alignment<Source> && has_alignment<Target>) {
+        // Alignments are powers of two: a larger one implies a smaller one
+        return Source.alignment >= Target.alignment;
+    } else if constexpr (has_size_multiple<Source> &&
+                         has_size_multiple<Target>) {
+        return Source.multiple % Target.multiple == 0;
     } else {
         // Predicate -> Predicate (including Interval -> Predicate):
         // requires explicit traits::implies specialization.
@@ -72,9 +125,8 @@ class Refined {
 
     // Helper to build error message
     static consteval std::string build_error_message(const T& value) {
-        using namespace std::meta;
         std::string msg = "Refinement violation: ";
-        msg += display_string_of(reflect_constant(value));
+        msg += detail::format_value(value);
         msg += " does not satisfy predicate";
         return msg;
     }
@@ -276,14 +328,251 @@ consteval std::meta::info type_info(const Refined<T, Predicate>&) {
     return ^^Refined<T, Predicate>;
 }
 
+namespace detail {
+
+// 64-bit FNV-1a of text, continuing from hash
+consteval std::uint64_t fnv1a(std::string_view text,
+                              std::uint64_t hash = 0xcbf29ce484222325) {
+    for (char c : text) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
+
+// fnv1a over the eight bytes of value, least significant first
+consteval std::uint64_t fnv1a_value(std::uint64_t value, std::uint64_t hash) {
+    for (int i = 0; i < 8; ++i, value >>= 8) {
+        hash ^= value & 0xff;
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
+
+// Continues hash with where each closure type that r names is written:
+// r itself, its template arguments and the types of its value arguments,
+// recursively. display_string_of prints every lambda alike ("<lambda>"),
+// so without this Refined<int, [](int v) { return v > 0; }> and
+// Refined<int, [](int v) { return v != 0; }> would hash the same.
+consteval std::uint64_t closure_locations(std::meta::info r,
+                                          std::uint64_t hash) {
+    if (!std::meta::is_type(r))
+        return closure_locations(std::meta::type_of(r), hash);
+    r = std::meta::dealias(r);
+    if (std::meta::is_class_type(r) && !std::meta::has_identifier(r)) {
+        const auto where = std::meta::source_location_of(r);
+        hash = fnv1a(where.file_name(), hash);
+        hash = fnv1a_value(where.line(), hash);
+        hash = fnv1a_value(where.column(), hash);
+    }
+    if (std::meta::has_template_arguments(r))
+        for (std::meta::info arg : std::meta::template_arguments_of(r))
+            hash = closure_locations(arg, hash);
+    return hash;
+}
+
+// Hash of the reflected name of r, with closure_locations mixed in
+consteval std::uint64_t
+fingerprint_of(std::meta::info r, std::uint64_t hash = 0xcbf29ce484222325) {
+    return closure_locations(r, fnv1a(std::meta::display_string_of(r), hash));
+}
+
+} // namespace detail
+
+// 64-bit FNV-1a hash of the reflected name of T, predicate included for a
+// Refined type. Shared-memory and on-disk formats compare it to check that
+// writer and reader mean the same refinement. A lambda predicate is
+// identified by the file, line and column of its lambda-expression, so
+// only builds of the same source are guaranteed to agree; structural
+// predicates such as Interval<Lo, Hi> are stable across edits.
+template <typename T>
+inline constexpr std::uint64_t type_fingerprint = detail::fingerprint_of(^^T);
+
+// Bounded-width text output for interval-refined integers
+namespace detail {
+
+// Interval predicate with integral bounds
+template <auto Pred>
+concept integral_interval =
+    has_interval_bounds<Pred> && std::integral<decltype(Pred.lo)> &&
+    std::integral<decltype(Pred.hi)>;
+
+// Interval bound clamped to the representable range of T
+template <typename T, auto Bound> consteval T clamp_bound() {
+    if constexpr (std::cmp_less(Bound, std::numeric_limits<T>::min()))
+        return std::numeric_limits<T>::min();
+    else if constexpr (std::cmp_greater(Bound, std::numeric_limits<T>::max()))
+        return std::numeric_limits<T>::max();
+    else
+        return static_cast<T>(Bound);
+}
+
+// Integral interval whose bounds, clamped to T, admit exactly the values of
+// T the predicate admits. That holds when the interval overlaps T's range;
+// one entirely outside it would collapse onto T's min or max and admit a
+// value the predicate rejects.
+template <typename T, auto Pred>
+concept clamped_interval =
+    std::integral<T> && integral_interval<Pred> &&
+    std::cmp_less_equal(Pred.lo, Pred.hi) &&
+    std::cmp_less_equal(Pred.lo, std::numeric_limits<T>::max()) &&
+    std::cmp_greater_equal(Pred.hi, std::numeric_limits<T>::min());
+
+// Integers that std::format prints as numbers (not bool or characters)
+template <typename T>
+concept formatted_as_number =
+    std::integral<T> && !std::same_as<T, bool> && !std::same_as<T, char> &&
+    !std::same_as<T, wchar_t> && !std::same_as<T, char8_t> &&
+    !std::same_as<T, char16_t> && !std::same_as<T, char32_t>;
+
+template <typename T, auto Pred>
+concept bounded_integral = formatted_as_number<T> && integral_interval<Pred>;
+
+// "00" "01" ... "99"
+inline constexpr std::array<char, 200> digit_pairs = [] {
+    std::array<char, 200> pairs{};
+    for (std::size_t i = 0; i < 100; ++i) {
+        pairs[2 * i] = static_cast<char>('0' + i / 10);
+        pairs[2 * i + 1] = static_cast<char>('0' + i % 10);
+    }
+    return pairs;
+}();
+
+// Text layout of Refined<T, Interval<Lo, Hi>>: the bounds fix the largest
+// digit count and whether a sign can occur, so output fits a small stack
+// buffer and non-negative intervals never test the sign.
+template <typename T, auto Pred>
+    requires bounded_integral<T, Pred>
+struct bounded_format {
+    using U = std::make_unsigned_t<T>;
+
+    static constexpr T lo = clamp_bound<T, Pred.lo>();
+    static constexpr T hi = clamp_bound<T, Pred.hi>();
+    static constexpr U max_magnitude = [] {
+        U neg = lo < 0 ? static_cast<U>(U{0} - static_cast<U>(lo)) : U{0};
+        U pos = hi > 0 ? static_cast<U>(hi) : U{0};
+        return neg > pos ? neg : pos;
+    }();
+    static constexpr unsigned max_digits = [] {
+        unsigned n = 1;
+        for (U m = max_magnitude; m >= 10; m /= 10)
+            ++n;
+        return n;
+    }();
+    static constexpr std::size_t max_chars = max_digits + (lo < 0 ? 1 : 0);
+
+    // False for values built with assume_valid or loaded by a trusted path
+    // outside [lo, hi], which write() must not see
+    static constexpr bool in_bounds(T v) noexcept {
+        bool ok = true;
+        if constexpr (lo != std::numeric_limits<T>::min())
+            ok = ok && v >= lo;
+        if constexpr (hi != std::numeric_limits<T>::max())
+            ok = ok && v <= hi;
+        return ok;
+    }
+
+    // Write v, which must be in_bounds, at out, which must have room for
+    // max_chars; returns the end
+    static constexpr char* write(char* out, T v) noexcept {
+        U m = static_cast<U>(v);
+        if constexpr (hi < 0) {
+            *out++ = '-';
+            m = static_cast<U>(U{0} - m);
+        } else if constexpr (lo < 0) {
+            if (v < 0) {
+                *out++ = '-';
+                m = static_cast<U>(U{0} - m);
+            }
+        }
+
+        // Digit count, with a loop bounded by max_digits
+        unsigned n = 1;
+        for (std::uint64_t p = 10; n < max_digits && m >= p; p *= 10)
+            ++n;
+
+        char* const end = out + n;
+        char* p = end;
+        while (m >= 100) {
+            std::size_t i = static_cast<std::size_t>(m % 100) * 2;
+            m = static_cast<U>(m / 100);
+            p -= 2;
+            p[0] = digit_pairs[i];
+            p[1] = digit_pairs[i + 1];
+        }
+        if (m >= 10) {
+            std::size_t i = static_cast<std::size_t>(m) * 2;
+            p[-2] = digit_pairs[i];
+            p[-1] = digit_pairs[i + 1];
+        } else {
+            p[-1] = static_cast<char>('0' + m);
+        }
+        return end;
+    }
+};
+
+// Offset coding of interval-refined integers: a value v in [lo, hi] is
+// stored as v - lo in the narrowest unsigned type that holds hi - lo, so
+// Refined<int, Interval<1000, 1200>{}> needs one byte and eight bits.
+template <typename T, auto Pred>
+concept coded_integral =
+    std::integral<T> && !std::same_as<T, bool> && integral_interval<Pred>;
+
+template <typename T, auto Pred>
+    requires coded_integral<T, Pred>
+struct interval_code {
+    using U = std::make_unsigned_t<T>;
+
+    static constexpr T lo = clamp_bound<T, Pred.lo>();
+    static constexpr T hi = clamp_bound<T, Pred.hi>();
+    static constexpr U max_code =
+        static_cast<U>(static_cast<U>(hi) - static_cast<U>(lo));
+    static constexpr int bits = std::bit_width(max_code);
+
+    using storage_type = std::conditional_t<
+        bits <= 8, std::uint8_t,
+        std::conditional_t<
+            bits <= 16, std::uint16_t,
+            std::conditional_t<bits <= 32, std::uint32_t, std::uint64_t>>>;
+
+    static constexpr storage_type encode(T v) noexcept {
+        return static_cast<storage_type>(
+            static_cast<U>(static_cast<U>(v) - static_cast<U>(lo)));
+    }
+    static constexpr T decode(storage_type code) noexcept {
+        return static_cast<T>(static_cast<U>(static_cast<U>(lo) + code));
+    }
+};
+
+} // namespace detail
+
 } // namespace refinery
 
-// Formatter specialization for Refined types
+// Formatter specialization for Refined types. Interval-refined integers
+// formatted with an empty spec ("{}") take the bounded-width path; any other
+// spec, or a value outside the interval, is handled by std::formatter<T>.
 template <typename T, auto Pred>
 struct std::formatter<refinery::Refined<T, Pred>> : std::formatter<T> {
+  private:
+    bool default_spec_ = false;
+
+  public:
+    template <typename ParseContext> constexpr auto parse(ParseContext& ctx) {
+        default_spec_ = ctx.begin() == ctx.end() || *ctx.begin() == '}';
+        return std::formatter<T>::parse(ctx);
+    }
+
     template <typename FormatContext>
     auto format(const refinery::Refined<T, Pred>& val,
                 FormatContext& ctx) const {
+        if constexpr (refinery::detail::bounded_integral<T, Pred>) {
+            using layout = refinery::detail::bounded_format<T, Pred>;
+            if (default_spec_ && layout::in_bounds(val.get())) {
+                char buf[layout::max_chars];
+                char* end = layout::write(buf, val.get());
+                return std::copy(buf, end, ctx.out());
+            }
+        }
         return std::formatter<T>::format(val.get(), ctx);
     }
 };
@@ -0,0 +1,169 @@
+// reflect.hpp - Reflection-driven validation of aggregates
+// Part of the C++26 Refinement Types Library
+//
+// Valid<S> is a predicate over a struct S built by walking S's data members
+// with C++26 reflection. A member takes part when it is annotated with
+// check<Pred>, or when its type is itself a Refined<T, Pred>:
+//
+//   struct Order {
+//       [[=check<Positive>]] std::int32_t quantity;
+//       [[=check<Finite>, =check<NonNegative>]] double price;
+//       PortNumber<> port;
+//       std::string note;                    // not checked
+//   };
+//   using ValidOrder = Validated<Order>;     // Refined<Order, Valid<Order>>
+//   auto order = try_refine<ValidOrder>(decoded);
+//
+// This replaces hand-written All<OnMember<&S::a, P1>, ...> chains. Every
+// member check is evaluated and the results are combined with bitwise AND,
+// leaving one branch at the end instead of one short-circuit branch per
+// field. Refined members are re-checked because an aggregate filled from
+// raw bytes may carry values that never went through their constructor.
+//
+// invalid_fields(s) names the members that fail, for error reporting.
+
+#ifndef REFINERY_REFLECT_HPP
+#define REFINERY_REFLECT_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <meta>
+
+#include "refined_type.hpp"
+
+namespace refinery {
+
+namespace detail {
+
+struct check_tag {};
+
+} // namespace detail
+
+// Annotation attaching a predicate to a data member: [[=check<Pred>]]
+template <auto Pred> struct check_annotation : detail::check_tag {
+    static constexpr auto predicate = Pred;
+};
+
+template <auto Pred> inline constexpr check_annotation<Pred> check{};
+
+namespace detail {
+
+template <typename A>
+concept is_check_annotation = std::derived_from<A, check_tag>;
+
+template <typename S> consteval auto fields_of() {
+    return std::define_static_array(std::meta::nonstatic_data_members_of(
+        ^^S, std::meta::access_context::unchecked()));
+}
+
+template <std::meta::info Member> consteval auto annotations_on() {
+    return std::define_static_array(std::meta::annotations_of(Member));
+}
+
+template <std::meta::info Member>
+using field_type =
+    typename [:std::meta::remove_cvref(std::meta::type_of(Member)):];
+
+// Position of the member that the member pointer Member designates among
+// fields_of<S>(), or the number of fields if it is not a member of S
+template <typename S, auto Member> consteval std::size_t member_index() {
+    std::size_t index = fields_of<S>().size();
+    std::size_t i = 0;
+    template for (constexpr std::meta::info m : fields_of<S>()) {
+        if constexpr (std::is_same_v<decltype(&[:m:]), decltype(Member)>) {
+            if (&[:m:] == Member)
+                index = i;
+        }
+        ++i;
+    }
+    return index;
+}
+
+// True if Member carries a check<> annotation or has a Refined type
+template <std::meta::info Member> consteval bool is_checked_field() {
+    bool checked = is_refined<field_type<Member>>;
+    template for (constexpr std::meta::info a : annotations_on<Member>()) {
+        using A = typename [:std::meta::remove_cvref(std::meta::type_of(a)):];
+        checked = checked || is_check_annotation<A>;
+    }
+    return checked;
+}
+
+template <typename S> consteval std::size_t checked_field_count() {
+    std::size_t count = 0;
+    template for (constexpr std::meta::info m : fields_of<S>()) {
+        if (is_checked_field<m>())
+            ++count;
+    }
+    return count;
+}
+
+// The check<> annotations on one member, applied to a value of its type
+template <std::meta::info Member>
+constexpr bool check_annotations(const field_type<Member>& value) noexcept {
+    bool ok = true;
+    template for (constexpr std::meta::info a : annotations_on<Member>()) {
+        using A = typename [:std::meta::remove_cvref(std::meta::type_of(a)):];
+        if constexpr (is_check_annotation<A>)
+            ok &= static_cast<bool>(A::predicate(value));
+    }
+    return ok;
+}
+
+// All checks on one member's value, combined without short-circuiting
+template <std::meta::info Member>
+constexpr bool check_value(const field_type<Member>& value) noexcept {
+    using F = field_type<Member>;
+    bool ok = check_annotations<Member>(value);
+    if constexpr (is_refined<F>)
+        ok &= static_cast<bool>(F::predicate(value.get()));
+    return ok;
+}
+
+template <std::meta::info Member, typename S>
+constexpr bool check_field(const S& s) noexcept {
+    return check_value<Member>(s.[:Member:]);
+}
+
+template <typename S> constexpr bool check_fields(const S& s) noexcept {
+    bool ok = true;
+    template for (constexpr std::meta::info m : fields_of<S>()) {
+        ok &= check_field<m>(s);
+    }
+    return ok;
+}
+
+} // namespace detail
+
+// Aggregates with at least one annotated or Refined member
+template <typename S>
+concept validatable = std::is_class_v<S> && !is_refined<S> &&
+                      (detail::checked_field_count<S>() > 0);
+
+// Predicate: every annotated or Refined member of S satisfies its predicate
+template <validatable S>
+inline constexpr auto Valid =
+    [](const S& s) constexpr noexcept { return detail::check_fields(s); };
+
+// Refinement token for a fully validated aggregate
+template <validatable S> using Validated = Refined<S, Valid<S>>;
+
+// Names of the members of s that fail their checks, in declaration order
+template <validatable S>
+[[nodiscard]] std::vector<std::string_view> invalid_fields(const S& s) {
+    std::vector<std::string_view> names;
+    template for (constexpr std::meta::info m : detail::fields_of<S>()) {
+        constexpr std::string_view name = std::meta::identifier_of(m);
+        if (!detail::check_field<m>(s))
+            names.push_back(name);
+    }
+    return names;
+}
+
+} // namespace refinery
+
+#endif // REFINERY_REFLECT_HPP
@@ -0,0 +1,764 @@
+// regex.hpp - Compile-time regular expression predicates
+// Part of the C++26 Refinement Types Library
+//
+// Matches<"pattern"> is a predicate over std::string_view that accepts
+// strings fully matching the pattern (std::regex_match semantics). The
+// pattern is parsed at compile time, compiled to a DFA by subset
+// construction and minimized, so a runtime check is one table lookup per
+// byte with no allocation or backtracking:
+//
+//   using Ticker = Refined<std::string_view, Matches<"[A-Z]{1,5}">>;
+//   constexpr Ticker t{"AAPL"};                 // checked at compile time
+//   auto u = try_refine<Ticker>(user_input);     // DFA walk at runtime
+//
+// Supported syntax (byte-oriented, ECMAScript subset):
+//   literals, escapes \. \\ \n \t \r \f \v \0 \xHH
+//   ([\b] is a backspace; other letter or digit escapes such as \b, \B,
+//   \1 or \p are rejected rather than read as literals)
+//   .  (any byte except '\n' and '\r')
+//   \d \D \w \W \s \S, bracket expressions [a-z_], [^...]
+//   grouping (...) and (?:...), alternation |
+//   quantifiers * + ? {n} {n,} {n,m} (lazy '?' suffix accepted)
+//   ^ at the start and $ at the end of the pattern (matching is anchored)
+//
+// Malformed patterns are rejected at compile time with a diagnostic.
+
+#ifndef REFINERY_REGEX_HPP
+#define REFINERY_REGEX_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <meta>
+
+namespace refinery {
+
+// String literal usable as a non-type template argument
+template <std::size_t N> struct fixed_string {
+    char data[N]{};
+
+    consteval fixed_string(const char (&str)[N]) {
+        std::copy_n(str, N, data);
+    }
+
+    [[nodiscard]] constexpr std::string_view view() const noexcept {
+        return {data, N - 1};
+    }
+};
+
+namespace detail::regex {
+
+// Set of bytes, one bit per value
+struct byte_set {
+    std::array<std::uint64_t, 4> bits{};
+
+    constexpr void add(unsigned c) {
+        bits[c / 64] |= std::uint64_t{1} << (c % 64);
+    }
+
+    constexpr void add_range(unsigned lo, unsigned hi) {
+        for (unsigned c = lo; c <= hi; ++c)
+            add(c);
+    }
+
+    constexpr void add(const byte_set& other) {
+        for (std::size_t i = 0; i < 4; ++i)
+            bits[i] |= other.bits[i];
+    }
+
+    [[nodiscard]] constexpr bool contains(unsigned c) const {
+        return ((bits[c / 64] >> (c % 64)) & 1u) != 0;
+    }
+
+    [[nodiscard]] constexpr byte_set complement() const {
+        byte_set out;
+        for (std::size_t i = 0; i < 4; ++i)
+            out.bits[i] = ~bits[i];
+        return out;
+    }
+};
+
+inline constexpr std::size_t max_repeat = 1000;
+inline constexpr std::size_t max_dfa_states = 4096;
+
+// Pattern syntax tree
+enum class node_kind { empty, set, concat, alternate, repeat };
+
+struct node {
+    node_kind kind = node_kind::empty;
+    byte_set set;
+    std::vector<std::size_t> children;
+    std::size_t min = 0;
+    std::size_t max = 0; // infinite when unbounded
+    bool unbounded = false;
+};
+
+struct pattern_error {};
+
+[[noreturn]] consteval void fail(std::string_view what,
+                                 std::string_view pattern,
+                                 std::size_t pos) {
+    std::string msg = "Invalid regex pattern \"";
+    msg += pattern;
+    msg += "\" at offset ";
+    std::string digits;
+    do {
+        digits.insert(digits.begin(), static_cast<char>('0' + pos % 10));
+        pos /= 10;
+    } while (pos != 0);
+    msg += digits;
+    msg += ": ";
+    msg += what;
+    throw std::meta::exception(msg, ^^pattern_error);
+}
+
+consteval byte_set digit_set() {
+    byte_set s;
+    s.add_range('0', '9');
+    return s;
+}
+
+consteval byte_set word_set() {
+    byte_set s;
+    s.add_range('a', 'z');
+    s.add_range('A', 'Z');
+    s.add_range('0', '9');
+    s.add('_');
+    return s;
+}
+
+consteval byte_set space_set() {
+    byte_set s;
+    s.add(' ');
+    s.add_range('\t', '\r');
+    return s;
+}
+
+// Recursive-descent parser producing a syntax tree
+class parser {
+  public:
+    consteval explicit parser(std::string_view pattern) : src_(pattern) {}
+
+    consteval std::vector<node> parse(std::size_t& root) {
+        if (peek('^'))
+            ++pos_;
+        root = parse_alternation();
+        if (pos_ != src_.size())
+            fail("unmatched ')'", src_, pos_);
+        return std::move(nodes_);
+    }
+
+  private:
+    std::string_view src_;
+    std::size_t pos_ = 0;
+    std::vector<node> nodes_;
+
+    consteval bool at_end() const { return pos_ >= src_.size(); }
+
+    consteval bool peek(char c) const { return !at_end() && src_[pos_] == c; }
+
+    consteval unsigned next_byte() {
+        return static_cast<unsigned char>(src_[pos_++]);
+    }
+
+    consteval std::size_t add(node n) {
+        nodes_.push_back(std::move(n));
+        return nodes_.size() - 1;
+    }
+
+    consteval std::size_t add_set(const byte_set& s) {
+        node n;
+        n.kind = node_kind::set;
+        n.set = s;
+        return add(std::move(n));
+    }
+
+    consteval std::size_t parse_alternation() {
+        std::vector<std::size_t> branches{parse_concatenation()};
+        while (peek('|')) {
+            ++pos_;
+            branches.push_back(parse_concatenation());
+        }
+        if (branches.size() == 1)
+            return branches[0];
+        node n;
+        n.kind = node_kind::alternate;
+        n.children = std::move(branches);
+        return add(std::move(n));
+    }
+
+    consteval std::size_t parse_concatenation() {
+        std::vector<std::size_t> items;
+        while (!at_end() && !peek('|') && !peek(')')) {
+            if (peek('$') && pos_ + 1 == src_.size()) {
+                ++pos_; // trailing anchor: matching is anchored anyway
+                break;
+            }
+            items.push_back(parse_quantified());
+        }
+        if (items.size() == 1)
+            return items[0];
+        node n;
+        n.kind = items.empty() ? node_kind::empty : node_kind::concat;
+        n.children = std::move(items);
+        return add(std::move(n));
+    }
+
+    consteval std::size_t parse_count() {
+        if (at_end() || src_[pos_] < '0' || src_[pos_] > '9')
+            fail("expected repetition count", src_, pos_);
+        std::size_t value = 0;
+        while (!at_end() && src_[pos_] >= '0' && src_[pos_] <= '9') {
+            value = value * 10 + static_cast<std::size_t>(src_[pos_++] - '0');
+            if (value > max_repeat)
+                fail("repetition count too large", src_, pos_);
+        }
+        return value;
+    }
+
+    consteval std::size_t parse_quantified() {
+        std::size_t atom = parse_atom();
+        while (!at_end()) {
+            std::size_t min = 0;
+            std::size_t max = 0;
+            bool unbounded = false;
+            char c = src_[pos_];
+            if (c == '*') {
+                unbounded = true;
+                ++pos_;
+            } else if (c == '+') {
+                min = 1;
+                unbounded = true;
+                ++pos_;
+            } else if (c == '?') {
+                max = 1;
+                ++pos_;
+            } else if (c == '{') {
+                ++pos_;
+                min = parse_count();
+                max = min;
+                if (peek(',')) {
+                    ++pos_;
+                    if (peek('}'))
+                        unbounded = true;
+                    else
+                        max = parse_count();
+                }
+                if (!peek('}'))
+                    fail("expected '}'", src_, pos_);
+                ++pos_;
+                if (!unbounded && max < min)
+                    fail("repetition range out of order", src_, pos_);
+            } else {
+                break;
+            }
+            if (peek('?'))
+                ++pos_; // lazy quantifier: same language
+            node n;
+            n.kind = node_kind::repeat;
+            n.children = {atom};
+            n.min = min;
+            n.max = max;
+            n.unbounded = unbounded;
+            atom = add(std::move(n));
+        }
+        return atom;
+    }
+
+    // Escape after a backslash, as a set; class escapes allowed. Inside a
+    // bracket expression \b is a backspace, as in ECMAScript.
+    consteval byte_set parse_escape(bool in_class) {
+        if (at_end())
+            fail("trailing backslash", src_, pos_);
+        unsigned c = next_byte();
+        byte_set s;
+        switch (c) {
+        case 'd':
+            return digit_set();
+        case 'D':
+            return digit_set().complement();
+        case 'w':
+            return word_set();
+        case 'W':
+            return word_set().complement();
+        case 's':
+            return space_set();
+        case 'S':
+            return space_set().complement();
+        case 'n':
+            s.add('\n');
+            return s;
+        case 't':
+            s.add('\t');
+            return s;
+        case 'r':
+            s.add('\r');
+            return s;
+        case 'f':
+            s.add('\f');
+            return s;
+        case 'v':
+            s.add('\v');
+            return s;
+        case '0':
+            s.add(0);
+            return s;
+        case 'x': {
+            unsigned value = 0;
+            for (int i = 0; i < 2; ++i) {
+                if (at_end())
+                    fail("incomplete \\x escape", src_, pos_);
+                unsigned h = next_byte();
+                if (h >= '0' && h <= '9')
+                    value = value * 16 + (h - '0');
+                else if (h >= 'a' && h <= 'f')
+                    value = value * 16 + (h - 'a' + 10);
+                else if (h >= 'A' && h <= 'F')
+                    value = value * 16 + (h - 'A' + 10);
+                else
+                    fail("invalid \\x escape", src_, pos_ - 1);
+            }
+            s.add(value);
+            return s;
+        }
+        case 'b':
+            if (!in_class)
+                fail("word boundaries are not supported", src_, pos_ - 2);
+            s.add('\b');
+            return s;
+        default:
+            // Other letters and digits name assertions, back-references
+            // and Unicode classes that matching by bytes cannot follow
+            if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                (c >= '0' && c <= '9'))
+                fail("unsupported escape", src_, pos_ - 2);
+            s.add(c);
+            return s;
+        }
+    }
+
+    // Single byte inside a bracket expression, for range endpoints
+    consteval unsigned parse_class_byte(bool& is_class, byte_set& set) {
+        is_class = false;
+        if (peek('\\')) {
+            ++pos_;
+            set = parse_escape(true);
+            unsigned count = 0;
+            unsigned only = 0;
+            for (unsigned c = 0; c < 256; ++c) {
+                if (set.contains(c)) {
+                    ++count;
+                    only = c;
+                }
+            }
+            is_class = count != 1;
+            return only;
+        }
+        return next_byte();
+    }
+
+    consteval byte_set parse_bracket() {
+        bool negate = false;
+        if (peek('^')) {
+            negate = true;
+            ++pos_;
+        }
+        byte_set s;
+        bool first = true;
+        while (true) {
+            if (at_end())
+                fail("unterminated '['", src_, pos_);
+            if (peek(']') && !first)
+                break;
+            first = false;
+            bool lo_is_class = false;
+            byte_set lo_set;
+            unsigned lo = parse_class_byte(lo_is_class, lo_set);
+            if (lo_is_class) {
+                s.add(lo_set);
+                continue;
+            }
+            if (peek('-') && pos_ + 1 < src_.size() && src_[pos_ + 1] != ']') {
+                ++pos_;
+                bool hi_is_class = false;
+                byte_set hi_set;
+                unsigned hi = parse_class_byte(hi_is_class, hi_set);
+                if (hi_is_class)
+                    fail("character class in range", src_, pos_);
+                if (hi < lo)
+                    fail("character range out of order", src_, pos_);
+                s.add_range(lo, hi);
+            } else {
+                s.add(lo);
+            }
+        }
+        ++pos_; // ']'
+        return negate ? s.complement() : s;
+    }
+
+    consteval std::size_t parse_atom() {
+        std::size_t start = pos_;
+        unsigned c = next_byte();
+        switch (c) {
+        case '(': {
+            if (src_.substr(pos_, 2) == "?:")
+                pos_ += 2;
+            std::size_t inner = parse_alternation();
+            if (!peek(')'))
+                fail("unmatched '('", src_, start);
+            ++pos_;
+            return inner;
+        }
+        case '[':
+            return add_set(parse_bracket());
+        case '.': {
+            byte_set s;
+            s.add_range(0, 255);
+            s.bits['\n' / 64] &= ~(std::uint64_t{1} << ('\n' % 64));
+            s.bits['\r' / 64] &= ~(std::uint64_t{1} << ('\r' % 64));
+            return add_set(s);
+        }
+        case '\\':
+            return add_set(parse_escape(false));
+        case '*':
+        case '+':
+        case '?':
+        case '{':
+            fail("quantifier without operand", src_, start);
+        case '^':
+        case '$':
+            fail("anchors are only allowed at the ends of the pattern", src_,
+                 start);
+        default: {
+            byte_set s;
+            s.add(c);
+            return add_set(s);
+        }
+        }
+    }
+};
+
+// Thompson NFA: each state has either one byte-set edge or epsilon edges
+struct nfa_state {
+    bool has_edge = false;
+    byte_set edge;
+    std::size_t target = 0;
+    std::vector<std::size_t> epsilon;
+};
+
+struct nfa {
+    std::vector<nfa_state> states;
+    std::size_t start = 0;
+    std::size_t accept = 0;
+};
+
+class nfa_builder {
+  public:
+    consteval nfa_builder(const std::vector<node>& nodes) : nodes_(nodes) {}
+
+    consteval nfa build(std::size_t root) {
+        auto [s, e] = fragment(root);
+        nfa out;
+        out.states = std::move(states_);
+        out.start = s;
+        out.accept = e;
+        return out;
+    }
+
+  private:
+    const std::vector<node>& nodes_;
+    std::vector<nfa_state> states_;
+
+    consteval std::size_t new_state() {
+        states_.emplace_back();
+        return states_.size() - 1;
+    }
+
+    consteval void eps(std::size_t from, std::size_t to) {
+        states_[from].epsilon.push_back(to);
+    }
+
+    consteval std::pair<std::size_t, std::size_t> fragment(std::size_t id) {
+        const node& n = nodes_[id];
+        switch (n.kind) {
+        case node_kind::empty: {
+            std::size_t s = new_state();
+            return {s, s};
+        }
+        case node_kind::set: {
+            std::size_t s = new_state();
+            std::size_t e = new_state();
+            states_[s].has_edge = true;
+            states_[s].edge = n.set;
+            states_[s].target = e;
+            return {s, e};
+        }
+        case node_kind::concat: {
+            auto [s, e] = fragment(n.children[0]);
+            for (std::size_t i = 1; i < n.children.size(); ++i) {
+                auto [cs, ce] = fragment(n.children[i]);
+                eps(e, cs);
+                e = ce;
+            }
+            return {s, e};
+        }
+        case node_kind::alternate: {
+            std::size_t s = new_state();
+            std::size_t e = new_state();
+            for (std::size_t child : n.children) {
+                auto [cs, ce] = fragment(child);
+                eps(s, cs);
+                eps(ce, e);
+            }
+            return {s, e};
+        }
+        case node_kind::repeat: {
+            std::size_t s = new_state();
+            std::size_t cur = s;
+            for (std::size_t i = 0; i < n.min; ++i) {
+                auto [cs, ce] = fragment(n.children[0]);
+                eps(cur, cs);
+                cur = ce;
+            }
+            std::size_t e = new_state();
+            if (n.unbounded) {
+                std::size_t hub = new_state();
+                auto [cs, ce] = fragment(n.children[0]);
+                eps(cur, hub);
+                eps(hub, cs);
+                eps(ce, hub);
+                eps(hub, e);
+            } else {
+                for (std::size_t i = n.min; i < n.max; ++i) {
+                    auto [cs, ce] = fragment(n.children[0]);
+                    eps(cur, e);
+                    eps(cur, cs);
+                    cur = ce;
+                }
+                eps(cur, e);
+            }
+            return {s, e};
+        }
+        }
+        return {0, 0};
+    }
+};
+
+// Minimized DFA in growable form (only used during constant evaluation).
+// State 0 is the dead state.
+struct dfa_tables {
+    std::array<std::uint8_t, 256> byte_class{};
+    std::size_t classes = 0;
+    std::size_t states = 0;
+    std::vector<std::size_t> next; // states * classes
+    std::vector<bool> accepting;
+    std::size_t start = 0;
+};
+
+// Partition bytes into classes that every byte set treats identically
+consteval std::size_t compute_byte_classes(const std::vector<nfa_state>& nfa,
+                                           std::array<std::uint8_t, 256>& cls) {
+    std::size_t count = 1;
+    cls.fill(0);
+    for (const nfa_state& st : nfa) {
+        if (!st.has_edge)
+            continue;
+        std::array<int, 512> remap{};
+        remap.fill(-1);
+        std::size_t next_id = 0;
+        for (unsigned b = 0; b < 256; ++b) {
+            std::size_t key = cls[b] * 2u + (st.edge.contains(b) ? 1u : 0u);
+            if (remap[key] < 0)
+                remap[key] = static_cast<int>(next_id++);
+            cls[b] = static_cast<std::uint8_t>(remap[key]);
+        }
+        count = next_id;
+    }
+    return count;
+}
+
+consteval void epsilon_closure(const nfa& automaton,
+                               std::vector<bool>& set) {
+    std::vector<std::size_t> stack;
+    for (std::size_t i = 0; i < set.size(); ++i) {
+        if (set[i])
+            stack.push_back(i);
+    }
+    while (!stack.empty()) {
+        std::size_t s = stack.back();
+        stack.pop_back();
+        for (std::size_t t : automaton.states[s].epsilon) {
+            if (!set[t]) {
+                set[t] = true;
+                stack.push_back(t);
+            }
+        }
+    }
+}
+
+consteval dfa_tables compile_pattern(std::string_view pattern) {
+    std::size_t root = 0;
+    parser p(pattern);
+    std::vector<node> tree = p.parse(root);
+    nfa automaton = nfa_builder(tree).build(root);
+
+    dfa_tables out;
+    out.classes = compute_byte_classes(automaton.states, out.byte_class);
+    const std::size_t classes = out.classes;
+    std::vector<unsigned> representative(classes, 0);
+    for (unsigned b = 256; b-- > 0;)
+        representative[out.byte_class[b]] = b;
+
+    // Subset construction; dead state (empty set) is state 0
+    const std::size_t n = automaton.states.size();
+    std::vector<std::vector<bool>> subsets;
+    subsets.emplace_back(n, false);
+    std::vector<bool> start(n, false);
+    start[automaton.start] = true;
+    epsilon_closure(automaton, start);
+    subsets.push_back(std::move(start));
+
+    std::vector<std::size_t> next;
+    for (std::size_t d = 0; d < subsets.size(); ++d) {
+        for (std::size_t c = 0; c < classes; ++c) {
+            std::vector<bool> target(n, false);
+            for (std::size_t s = 0; s < n; ++s) {
+                const nfa_state& st = automaton.states[s];
+                if (subsets[d][s] && st.has_edge &&
+                    st.edge.contains(representative[c]))
+                    target[st.target] = true;
+            }
+            epsilon_closure(automaton, target);
+            std::size_t id = 0;
+            while (id < subsets.size() && subsets[id] != target)
+                ++id;
+            if (id == subsets.size()) {
+                if (subsets.size() == max_dfa_states)
+                    fail("pattern needs too many DFA states", pattern, 0);
+                subsets.push_back(std::move(target));
+            }
+            next.push_back(id);
+        }
+    }
+
+    // Moore minimization: refine {accepting, rejecting} until stable
+    const std::size_t count = subsets.size();
+    std::vector<std::size_t> block(count);
+    for (std::size_t d = 0; d < count; ++d)
+        block[d] = subsets[d][automaton.accept] ? 1 : 0;
+    std::size_t blocks = 0;
+    while (true) {
+        std::vector<std::vector<std::size_t>> signatures;
+        std::vector<std::size_t> refined(count);
+        for (std::size_t d = 0; d < count; ++d) {
+            std::vector<std::size_t> sig{block[d]};
+            for (std::size_t c = 0; c < classes; ++c)
+                sig.push_back(block[next[d * classes + c]]);
+            std::size_t id = 0;
+            while (id < signatures.size() && signatures[id] != sig)
+                ++id;
+            if (id == signatures.size())
+                signatures.push_back(std::move(sig));
+            refined[d] = id;
+        }
+        bool stable = signatures.size() == blocks;
+        blocks = signatures.size();
+        block = std::move(refined);
+        if (stable)
+            break;
+    }
+
+    // The dead state is scanned first, so its block is 0
+    out.states = blocks;
+    out.next.assign(blocks * classes, 0);
+    out.accepting.assign(blocks, false);
+    for (std::size_t d = 0; d < count; ++d) {
+        for (std::size_t c = 0; c < classes; ++c)
+            out.next[block[d] * classes + c] = block[next[d * classes + c]];
+        out.accepting[block[d]] = subsets[d][automaton.accept];
+    }
+    out.start = block[1];
+    return out;
+}
+
+struct dfa_shape {
+    std::size_t states;
+    std::size_t classes;
+};
+
+consteval dfa_shape measure(std::string_view pattern) {
+    dfa_tables t = compile_pattern(pattern);
+    return {t.states, t.classes};
+}
+
+// Fixed-size DFA. Transitions store pre-multiplied row offsets
+// (state * Classes), so the inner loop is one add and one load per byte.
+template <std::size_t States, std::size_t Classes> struct dfa {
+    using offset_type =
+        std::conditional_t<(States * Classes <= 0xffff), std::uint16_t,
+                           std::uint32_t>;
+
+    std::array<std::uint8_t, 256> byte_class{};
+    std::array<offset_type, States * Classes> next{};
+    std::array<bool, States> accepting{};
+    offset_type start = 0;
+
+    [[nodiscard]] constexpr bool match(std::string_view s) const noexcept {
+        offset_type row = start;
+        for (char ch : s) {
+            row = next[row + byte_class[static_cast<unsigned char>(ch)]];
+            if (row == 0)
+                return false; // dead state: no completion can match
+        }
+        return accepting[row / Classes];
+    }
+};
+
+template <std::size_t States, std::size_t Classes>
+consteval dfa<States, Classes> build_dfa(std::string_view pattern) {
+    using offset_type = typename dfa<States, Classes>::offset_type;
+    dfa_tables t = compile_pattern(pattern);
+    dfa<States, Classes> out;
+    out.byte_class = t.byte_class;
+    for (std::size_t i = 0; i < States * Classes; ++i)
+        out.next[i] = static_cast<offset_type>(t.next[i] * Classes);
+    for (std::size_t s = 0; s < States; ++s)
+        out.accepting[s] = t.accepting[s];
+    out.start = static_cast<offset_type>(t.start * Classes);
+    return out;
+}
+
+} // namespace detail::regex
+
+// Structural regex predicate: the compiled DFA is a static member, so
+// RegexPredicate<Pattern>{} is valid as an NTTP.
+template <fixed_string Pattern> struct RegexPredicate {
+    static constexpr auto pattern = Pattern;
+
+  private:
+    static constexpr detail::regex::dfa_shape shape =
+        detail::regex::measure(Pattern.view());
+
+  public:
+    static constexpr auto dfa =
+        detail::regex::build_dfa<shape.states, shape.classes>(Pattern.view());
+
+    constexpr bool operator()(std::string_view s) const noexcept {
+        return dfa.match(s);
+    }
+};
+
+// True if the whole string matches Pattern
+template <fixed_string Pattern>
+inline constexpr RegexPredicate<Pattern> Matches{};
+
+} // namespace refinery
+
+#endif // REFINERY_REGEX_HPP
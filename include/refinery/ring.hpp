@@ -0,0 +1,472 @@
+// ring.hpp - Lock-free ring buffers of refined values
+// Part of the C++26 Refinement Types Library
+//
+// Queues that carry Refined<T, P> values from producers to consumers, so a
+// value validated once by the producer reaches the consumer still refined:
+//
+//   SpscRing<PortNumber<>> ports(Refined<std::size_t, PowerOfTwo>{1024});
+//   ports.try_push(PortNumber<>{8080});            // producer thread
+//   if (auto port = ports.try_pop())               // consumer thread
+//       connect(*port);                            // no re-validation
+//
+// - SpscRing<R>: one producer, one consumer. Each side caches the other's
+//   index and only reloads it when the ring looks full (or empty), so a
+//   steady stream costs one release store per push or batch.
+// - MpmcRing<R>: any number of producers and consumers, using a sequence
+//   number per slot (Vyukov's bounded queue).
+// - SharedSpscRing<R>: an SpscRing in a POSIX shared-memory segment, for
+//   handing refined values between processes. The segment header records
+//   type_fingerprint<R>, so a process opening it with a different type or
+//   predicate is refused instead of trusting values it cannot vouch for.
+//   create() never reuses an existing segment, which a peer may still
+//   have mapped; remove() the name first.
+//
+// Capacities are Refined<std::size_t, PowerOfTwo>, so indexing is a mask and
+// the constructor never checks, except that MpmcRing needs at least two
+// slots and throws refinement_error for a capacity of 1. T must be
+// trivially copyable; slots hold the underlying T and are re-wrapped with
+// assume_valid on the way out.
+
+#ifndef REFINERY_RING_HPP
+#define REFINERY_RING_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<sys/mman.h>)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define REFINERY_HAS_SHM 1
+#endif
+
+#include "counter.hpp"
+#include "predicates.hpp"
+#include "refined_type.hpp"
+
+namespace refinery {
+
+using RingCapacity = Refined<std::size_t, PowerOfTwo>;
+
+template <typename R>
+concept ring_element =
+    is_refined<R> && std::is_trivially_copyable_v<typename R::value_type> &&
+    std::default_initializable<typename R::value_type>;
+
+namespace detail {
+
+struct alignas(cache_line_size) ring_cursor {
+    std::atomic<std::size_t> value{0};
+};
+
+// Indices shared by the producer and the consumer of an SPSC ring
+struct spsc_control {
+    ring_cursor head; // next slot to read
+    ring_cursor tail; // next slot to write
+};
+
+// SPSC ring over storage owned by someone else: a heap block for SpscRing,
+// a shared-memory mapping for SharedSpscRing
+template <ring_element R> class spsc_core {
+    using T = typename R::value_type;
+
+    spsc_control* control_;
+    T* slots_;
+    std::size_t mask_;
+    alignas(cache_line_size) std::size_t cached_head_; // producer's copy
+    alignas(cache_line_size) std::size_t cached_tail_; // consumer's copy
+
+  public:
+    spsc_core(spsc_control* control, T* slots, RingCapacity capacity) noexcept
+        : control_(control), slots_(slots), mask_(capacity.get() - 1),
+          cached_head_(control->head.value.load(std::memory_order::acquire)),
+          cached_tail_(control->tail.value.load(std::memory_order::acquire)) {}
+
+    std::size_t capacity() const noexcept { return mask_ + 1; }
+
+    std::size_t size() const noexcept {
+        return control_->tail.value.load(std::memory_order::acquire) -
+               control_->head.value.load(std::memory_order::acquire);
+    }
+
+    // Producer: append up to values.size() values, returning how many fit
+    std::size_t push(std::span<const R> values) noexcept {
+        const std::size_t tail =
+            control_->tail.value.load(std::memory_order::relaxed);
+        std::size_t space = capacity() - (tail - cached_head_);
+        if (space < values.size()) {
+            cached_head_ =
+                control_->head.value.load(std::memory_order::acquire);
+            space = capacity() - (tail - cached_head_);
+        }
+        const std::size_t n = std::min(space, values.size());
+        for (std::size_t i = 0; i < n; ++i)
+            slots_[(tail + i) & mask_] = values[i].get();
+        if (n > 0)
+            control_->tail.value.store(tail + n, std::memory_order::release);
+        return n;
+    }
+
+    // Consumer: take the oldest value, if any
+    std::optional<R> try_pop() noexcept {
+        const std::size_t head =
+            control_->head.value.load(std::memory_order::relaxed);
+        if (cached_tail_ == head) {
+            cached_tail_ =
+                control_->tail.value.load(std::memory_order::acquire);
+            if (cached_tail_ == head)
+                return std::nullopt;
+        }
+        R value(slots_[head & mask_], assume_valid);
+        control_->head.value.store(head + 1, std::memory_order::release);
+        return value;
+    }
+
+    // Consumer: write up to max values to out, returning how many
+    template <std::output_iterator<R> Out>
+    std::size_t pop(Out out, std::size_t max) {
+        const std::size_t head =
+            control_->head.value.load(std::memory_order::relaxed);
+        std::size_t ready = cached_tail_ - head;
+        if (ready < max) {
+            cached_tail_ =
+                control_->tail.value.load(std::memory_order::acquire);
+            ready = cached_tail_ - head;
+        }
+        const std::size_t n = std::min(ready, max);
+        for (std::size_t i = 0; i < n; ++i)
+            *out++ = R(slots_[(head + i) & mask_], assume_valid);
+        if (n > 0)
+            control_->head.value.store(head + n, std::memory_order::release);
+        return n;
+    }
+};
+
+template <typename T> struct mpmc_slot {
+    std::atomic<std::size_t> sequence;
+    T value;
+};
+
+} // namespace detail
+
+// Single-producer single-consumer ring
+template <ring_element R> class SpscRing {
+    using T = typename R::value_type;
+
+    std::unique_ptr<detail::spsc_control> control_;
+    std::unique_ptr<T[]> slots_;
+    detail::spsc_core<R> core_;
+
+  public:
+    using value_type = R;
+
+    explicit SpscRing(RingCapacity capacity)
+        : control_(std::make_unique<detail::spsc_control>()),
+          slots_(std::make_unique_for_overwrite<T[]>(capacity.get())),
+          core_(control_.get(), slots_.get(), capacity) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return core_.capacity();
+    }
+    // Exact when called by the producer or consumer, approximate otherwise
+    [[nodiscard]] std::size_t size() const noexcept { return core_.size(); }
+
+    bool try_push(const R& value) noexcept {
+        return core_.push(std::span(&value, 1)) == 1;
+    }
+    std::size_t push(std::span<const R> values) noexcept {
+        return core_.push(values);
+    }
+
+    std::optional<R> try_pop() noexcept { return core_.try_pop(); }
+    template <std::output_iterator<R> Out>
+    std::size_t pop(Out out, std::size_t max) {
+        return core_.pop(out, max);
+    }
+};
+
+// Multi-producer multi-consumer ring
+template <ring_element R> class MpmcRing {
+    using T = typename R::value_type;
+
+    std::unique_ptr<detail::mpmc_slot<T>[]> slots_;
+    std::size_t mask_;
+    detail::ring_cursor enqueue_;
+    detail::ring_cursor dequeue_;
+
+  public:
+    using value_type = R;
+
+    // With one slot, "filled at pos" and "free at pos + 1" would share a
+    // sequence number, so a second push would overwrite the first
+    explicit MpmcRing(RingCapacity capacity)
+        : slots_(std::make_unique<detail::mpmc_slot<T>[]>(capacity.get())),
+          mask_(capacity.get() - 1) {
+        if (capacity.get() < 2)
+            throw refinement_error(
+                std::string("MpmcRing needs a capacity of at least 2"));
+        for (std::size_t i = 0; i < capacity.get(); ++i)
+            slots_[i].sequence.store(i, std::memory_order::relaxed);
+    }
+
+    MpmcRing(const MpmcRing&) = delete;
+    MpmcRing& operator=(const MpmcRing&) = delete;
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return mask_ + 1; }
+
+    bool try_push(const R& value) noexcept {
+        std::size_t pos = enqueue_.value.load(std::memory_order::relaxed);
+        for (;;) {
+            auto& slot = slots_[pos & mask_];
+            std::size_t seq = slot.sequence.load(std::memory_order::acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+            if (diff == 0) {
+                if (enqueue_.value.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order::relaxed)) {
+                    slot.value = value.get();
+                    slot.sequence.store(pos + 1, std::memory_order::release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // full
+            } else {
+                pos = enqueue_.value.load(std::memory_order::relaxed);
+            }
+        }
+    }
+
+    std::optional<R> try_pop() noexcept {
+        std::size_t pos = dequeue_.value.load(std::memory_order::relaxed);
+        for (;;) {
+            auto& slot = slots_[pos & mask_];
+            std::size_t seq = slot.sequence.load(std::memory_order::acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+            if (diff == 0) {
+                if (dequeue_.value.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order::relaxed)) {
+                    R value(slot.value, assume_valid);
+                    slot.sequence.store(pos + mask_ + 1,
+                                        std::memory_order::release);
+                    return value;
+                }
+            } else if (diff < 0) {
+                return std::nullopt; // empty
+            } else {
+                pos = dequeue_.value.load(std::memory_order::relaxed);
+            }
+        }
+    }
+
+    // Push values in order until the ring is full; returns how many
+    std::size_t push(std::span<const R> values) noexcept {
+        std::size_t n = 0;
+        while (n < values.size() && try_push(values[n]))
+            ++n;
+        return n;
+    }
+
+    // Pop up to max values into out; returns how many
+    template <std::output_iterator<R> Out>
+    std::size_t pop(Out out, std::size_t max) {
+        std::size_t n = 0;
+        for (; n < max; ++n) {
+            auto value = try_pop();
+            if (!value)
+                break;
+            *out++ = *value;
+        }
+        return n;
+    }
+};
+
+#if defined(REFINERY_HAS_SHM)
+
+// The indices are shared between processes, which is only sound for atomics
+// that never fall back to a lock (the lock would be per-process)
+static_assert(std::atomic<std::size_t>::is_always_lock_free,
+              "SharedSpscRing needs lock-free std::atomic<std::size_t>");
+
+// SpscRing in a named POSIX shared-memory segment. One process calls
+// create(), another open(); each then acts as producer or consumer.
+template <ring_element R> class SharedSpscRing {
+    using T = typename R::value_type;
+
+    static constexpr std::uint64_t magic = 0x676e6952'79726e66; // "fnryRing"
+
+    struct header {
+        std::uint64_t magic;
+        std::uint64_t fingerprint;
+        std::uint64_t capacity;
+        std::uint64_t slot_size;
+    };
+
+    static constexpr std::size_t control_offset =
+        (sizeof(header) + detail::cache_line_size - 1) /
+        detail::cache_line_size * detail::cache_line_size;
+    static constexpr std::size_t slots_offset =
+        control_offset + sizeof(detail::spsc_control);
+
+    static constexpr std::size_t bytes_for(std::size_t capacity) noexcept {
+        return slots_offset + capacity * sizeof(T);
+    }
+
+    void* base_;
+    std::size_t bytes_;
+    detail::spsc_core<R> core_;
+
+    SharedSpscRing(void* base, std::size_t bytes, RingCapacity capacity)
+        : base_(base), bytes_(bytes),
+          core_(reinterpret_cast<detail::spsc_control*>(
+                    static_cast<std::byte*>(base) + control_offset),
+                reinterpret_cast<T*>(static_cast<std::byte*>(base) +
+                                     slots_offset),
+                capacity) {}
+
+    static std::error_code last_error() noexcept {
+        return {errno, std::system_category()};
+    }
+
+  public:
+    using value_type = R;
+
+    // Create the segment `name`, e.g. "/quotes". Fails with
+    // errc::file_exists if it already exists: a peer may still have the
+    // old ring mapped, so replacing it takes an explicit remove() first.
+    static std::expected<SharedSpscRing, std::error_code>
+    create(const std::string& name, RingCapacity capacity) {
+        constexpr std::size_t max_capacity =
+            (std::numeric_limits<std::size_t>::max() - slots_offset) /
+            sizeof(T);
+        if (capacity.get() > max_capacity)
+            return std::unexpected(
+                std::make_error_code(std::errc::value_too_large));
+        int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0)
+            return std::unexpected(last_error());
+        const std::size_t bytes = bytes_for(capacity.get());
+        void* base = MAP_FAILED;
+        if (::ftruncate(fd, static_cast<off_t>(bytes)) == 0)
+            base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+                          fd, 0);
+        if (base == MAP_FAILED) {
+            // Do not leave a segment behind that open() would reject
+            auto ec = last_error();
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            return std::unexpected(ec);
+        }
+        ::close(fd);
+
+        auto* h = static_cast<header*>(base);
+        h->fingerprint = type_fingerprint<R>;
+        h->capacity = capacity.get();
+        h->slot_size = sizeof(T);
+        ::new (static_cast<std::byte*>(base) + control_offset)
+            detail::spsc_control{};
+        // Publish the header last, so open() never sees a half-built ring
+        std::atomic_ref(h->magic).store(magic, std::memory_order::release);
+        return SharedSpscRing(base, bytes, capacity);
+    }
+
+    // Map an existing segment created for the same R. Fails with
+    // errc::invalid_argument if it was created for another type or
+    // predicate, or is not (yet) a ring.
+    static std::expected<SharedSpscRing, std::error_code>
+    open(const std::string& name) {
+        int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0)
+            return std::unexpected(last_error());
+        struct stat st{};
+        if (::fstat(fd, &st) != 0) {
+            auto ec = last_error();
+            ::close(fd);
+            return std::unexpected(ec);
+        }
+        const auto bytes = static_cast<std::size_t>(st.st_size);
+        if (bytes < slots_offset) {
+            ::close(fd);
+            return std::unexpected(
+                std::make_error_code(std::errc::invalid_argument));
+        }
+        void* base =
+            ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED)
+            return std::unexpected(last_error());
+
+        auto* h = static_cast<header*>(base);
+        const bool is_ring =
+            std::atomic_ref(h->magic).load(std::memory_order::acquire) == magic;
+        const std::uint64_t capacity = h->capacity;
+        // Compared by division: bytes_for(capacity) can wrap around
+        if (!is_ring || h->fingerprint != type_fingerprint<R> ||
+            h->slot_size != sizeof(T) || !PowerOfTwo(capacity) ||
+            capacity > (bytes - slots_offset) / sizeof(T)) {
+            ::munmap(base, bytes);
+            return std::unexpected(
+                std::make_error_code(std::errc::invalid_argument));
+        }
+        return SharedSpscRing(base, bytes,
+                              RingCapacity(capacity, assume_valid));
+    }
+
+    // Remove the segment name; existing mappings stay valid
+    static std::error_code remove(const std::string& name) noexcept {
+        if (::shm_unlink(name.c_str()) != 0)
+            return last_error();
+        return {};
+    }
+
+    SharedSpscRing(SharedSpscRing&& other) noexcept
+        : base_(std::exchange(other.base_, nullptr)), bytes_(other.bytes_),
+          core_(other.core_) {}
+    SharedSpscRing& operator=(SharedSpscRing&&) = delete;
+    SharedSpscRing(const SharedSpscRing&) = delete;
+
+    ~SharedSpscRing() {
+        if (base_)
+            ::munmap(base_, bytes_);
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return core_.capacity();
+    }
+    [[nodiscard]] std::size_t size() const noexcept { return core_.size(); }
+
+    bool try_push(const R& value) noexcept {
+        return core_.push(std::span(&value, 1)) == 1;
+    }
+    std::size_t push(std::span<const R> values) noexcept {
+        return core_.push(values);
+    }
+
+    std::optional<R> try_pop() noexcept { return core_.try_pop(); }
+    template <std::output_iterator<R> Out>
+    std::size_t pop(Out out, std::size_t max) {
+        return core_.pop(out, max);
+    }
+};
+
+#endif // REFINERY_HAS_SHM
+
+} // namespace refinery
+
+#endif // REFINERY_RING_HPP
@@ -0,0 +1,311 @@
+// snapshot.hpp - On-disk arrays of refined values that reload without checks
+// Part of the C++26 Refinement Types Library
+//
+// write_snapshot stores an array of Refined<T, P> together with what the
+// values were checked against; Snapshot<R>::open maps it back and, once the
+// header and checksum agree, treats the payload as refined without running
+// the predicate:
+//
+//   write_snapshot<Price>("prices.snap", prices);     // trusted writer
+//   ...
+//   auto prices = Snapshot<Price>::open("prices.snap");
+//   if (!prices)
+//       return rebuild(prices.error());               // stale or damaged
+//   use(prices->values());                            // std::span<const Price>
+//
+// The file is a 64-byte header followed by the values in native layout:
+//
+//   magic "fnrySnap", format version, byte-order mark,
+//   type_fingerprint<R> (element type and predicate, via reflection),
+//   element size, element count,
+//   interval bounds (bit patterns of Lo and Hi as T; zero if P has none),
+//   checksum of the payload
+//
+// A reader compares every header field against its own R, so a file
+// written for another type, predicate, bounds, platform or version is
+// rejected before its payload is looked at. How much of the payload is
+// re-examined is the reader's choice (snapshot_check):
+//
+//   full      checksum, then the predicate on every element (untrusted)
+//   checksum  checksum only: one fast pass, no predicate (the default)
+//   header    nothing past the header, for files known to be intact
+//
+// Snapshots are written to a temporary file, flushed, and renamed into
+// place, so a reader never sees a partly written one.
+
+#ifndef REFINERY_SNAPSHOT_HPP
+#define REFINERY_SNAPSHOT_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <filesystem>
+#include <span>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "mmap.hpp"
+#include "refined_type.hpp"
+
+namespace refinery {
+
+#if defined(REFINERY_HAS_MMAP)
+
+// How much of a snapshot's payload Snapshot::open re-examines
+enum class snapshot_check { full, checksum, header };
+
+// Why Snapshot::open failed. `code` is set for io, `index` (the first
+// element that failed the predicate) for predicate_failed.
+struct snapshot_error {
+    enum class kind {
+        io,
+        bad_header,        // not a snapshot, or another version/platform
+        type_mismatch,     // element type or predicate differs
+        bounds_mismatch,   // interval bounds differ
+        checksum_mismatch, // payload damaged
+        predicate_failed
+    };
+    kind reason;
+    std::error_code code;
+    std::size_t index;
+};
+
+namespace detail::snapshot {
+
+inline constexpr std::uint64_t magic = 0x70616e53'79726e66; // "fnrySnap"
+inline constexpr std::uint32_t version = 1;
+inline constexpr std::uint32_t byte_order_mark = 0x01020304;
+
+struct header {
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t fingerprint;
+    std::uint64_t element_size;
+    std::uint64_t count;
+    std::uint64_t lo;
+    std::uint64_t hi;
+    std::uint64_t checksum;
+};
+static_assert(sizeof(header) == 64);
+
+// Bit pattern of v, zero-extended to 64 bits
+template <typename T> constexpr std::uint64_t bits_of(T v) noexcept {
+    if constexpr (sizeof(T) <= sizeof(std::uint64_t) &&
+                  std::is_trivially_copyable_v<T>) {
+        std::uint64_t out = 0;
+        std::memcpy(&out, &v, sizeof(T));
+        return out;
+    } else {
+        return 0;
+    }
+}
+
+// Interval bounds of R's predicate as stored in the header
+template <typename R>
+constexpr std::pair<std::uint64_t, std::uint64_t> bounds() noexcept {
+    using T = typename R::value_type;
+    constexpr auto pred = R::predicate;
+    if constexpr (!has_interval_bounds<pred> || !std::is_arithmetic_v<T>) {
+        return {0, 0};
+    } else if constexpr (integral_interval<pred> && std::integral<T>) {
+        return {bits_of(clamp_bound<T, pred.lo>()),
+                bits_of(clamp_bound<T, pred.hi>())};
+    } else {
+        return {bits_of(static_cast<T>(pred.lo)),
+                bits_of(static_cast<T>(pred.hi))};
+    }
+}
+
+inline std::uint64_t load_word(const std::byte* p) noexcept {
+    std::uint64_t w;
+    std::memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+inline constexpr std::uint64_t prime1 = 0x9e3779b185ebca87;
+inline constexpr std::uint64_t prime2 = 0xc2b2ae3d27d4eb4f;
+
+inline std::uint64_t mix(std::uint64_t acc, std::uint64_t word) noexcept {
+    return std::rotl(acc + word * prime2, 31) * prime1;
+}
+
+// 64-bit checksum of bytes using the xxHash64 round on four independent
+// lanes, so the pass runs at memory speed rather than one multiply chain
+inline std::uint64_t checksum(std::span<const std::byte> bytes) noexcept {
+    std::uint64_t lanes[4] = {prime1 + prime2, prime2, 0, 0 - prime1};
+    const std::byte* p = bytes.data();
+    std::size_t n = bytes.size();
+    for (; n >= 32; p += 32, n -= 32) {
+        for (int i = 0; i < 4; ++i)
+            lanes[i] = mix(lanes[i], load_word(p + 8 * i));
+    }
+    std::uint64_t h = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) +
+                      std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18);
+    h += bytes.size();
+    for (; n >= 8; p += 8, n -= 8)
+        h = std::rotl(h ^ mix(0, load_word(p)), 27) * prime1 + prime2;
+    for (; n > 0; ++p, --n)
+        h = std::rotl(h ^ (static_cast<std::uint64_t>(*p) * prime1), 11) *
+            prime2;
+    h ^= h >> 33;
+    h *= prime2;
+    h ^= h >> 29;
+    return h ^ (h >> 32);
+}
+
+template <typename R> header header_for(std::span<const R> values) noexcept {
+    const auto [lo, hi] = bounds<R>();
+    return header{magic,
+                  version,
+                  byte_order_mark,
+                  type_fingerprint<R>,
+                  sizeof(R),
+                  values.size(),
+                  lo,
+                  hi,
+                  checksum(std::as_bytes(values))};
+}
+
+inline std::error_code last_error() noexcept {
+    return {errno, std::system_category()};
+}
+
+// Write all of bytes to fd
+inline std::error_code write_all(int fd,
+                                 std::span<const std::byte> bytes) noexcept {
+    while (!bytes.empty()) {
+        ssize_t n = ::write(fd, bytes.data(), bytes.size());
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return last_error();
+        }
+        bytes = bytes.subspan(static_cast<std::size_t>(n));
+    }
+    return {};
+}
+
+} // namespace detail::snapshot
+
+// Write values to path as a snapshot, replacing any file already there
+template <mappable_refined R>
+std::error_code write_snapshot(const std::filesystem::path& path,
+                               std::span<const R> values) {
+    const auto h = detail::snapshot::header_for(values);
+    std::filesystem::path temporary = path;
+    temporary += ".tmp";
+
+    int fd = ::open(temporary.c_str(),
+                    O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+        return detail::snapshot::last_error();
+    std::error_code ec = detail::snapshot::write_all(
+        fd, std::as_bytes(std::span(&h, 1)));
+    if (!ec)
+        ec = detail::snapshot::write_all(fd, std::as_bytes(values));
+    if (!ec && ::fsync(fd) != 0)
+        ec = detail::snapshot::last_error();
+    if (::close(fd) != 0 && !ec)
+        ec = detail::snapshot::last_error();
+    if (!ec)
+        std::filesystem::rename(temporary, path, ec);
+    if (ec)
+        std::filesystem::remove(temporary);
+    return ec;
+}
+
+template <mappable_refined R> class Snapshot {
+    detail::file_mapping mapping_;
+    std::span<const R> values_;
+
+    Snapshot(detail::file_mapping mapping, std::span<const R> values)
+        : mapping_(std::move(mapping)), values_(values) {}
+
+    static std::unexpected<snapshot_error>
+    fail(snapshot_error::kind reason, std::size_t index = 0) {
+        return std::unexpected(snapshot_error{reason, {}, index});
+    }
+
+  public:
+    using value_type = R;
+
+    static std::expected<Snapshot, snapshot_error>
+    open(const std::filesystem::path& path,
+         snapshot_check check = snapshot_check::checksum) {
+        namespace ds = detail::snapshot;
+        using kind = snapshot_error::kind;
+
+        auto mapping = detail::file_mapping::open(path);
+        if (!mapping) {
+            return std::unexpected(
+                snapshot_error{kind::io, mapping.error(), 0});
+        }
+        const std::span<const std::byte> bytes = mapping->bytes();
+        if (bytes.size() < sizeof(ds::header))
+            return fail(kind::bad_header);
+
+        ds::header h;
+        std::memcpy(&h, bytes.data(), sizeof(h));
+        if (h.magic != ds::magic || h.version != ds::version ||
+            h.byte_order != ds::byte_order_mark)
+            return fail(kind::bad_header);
+        if (h.element_size != sizeof(R))
+            return fail(kind::type_mismatch);
+        if (std::pair(h.lo, h.hi) != ds::bounds<R>())
+            return fail(kind::bounds_mismatch);
+        if (h.fingerprint != type_fingerprint<R>)
+            return fail(kind::type_mismatch);
+
+        const std::span<const std::byte> payload =
+            bytes.subspan(sizeof(ds::header));
+        if (h.count > payload.size() / sizeof(R) ||
+            payload.size() != h.count * sizeof(R))
+            return fail(kind::bad_header);
+        // The header keeps the payload 64-byte aligned in the mapping
+        const std::span<const R> values(
+            reinterpret_cast<const R*>(payload.data()), h.count);
+
+        if (check != snapshot_check::header) {
+            mapping->advise_sequential_scan();
+            const bool intact = ds::checksum(payload) == h.checksum;
+            std::size_t bad = values.size();
+            if (intact && check == snapshot_check::full) {
+                const std::span<const typename R::value_type> raw(
+                    reinterpret_cast<const typename R::value_type*>(
+                        payload.data()),
+                    h.count);
+                bad = detail::bulk::first_failing<R::predicate>(raw);
+            }
+            mapping->advise(MADV_NORMAL);
+            if (!intact)
+                return fail(kind::checksum_mismatch);
+            if (bad != values.size())
+                return fail(kind::predicate_failed, bad);
+        }
+        return Snapshot(std::move(*mapping), values);
+    }
+
+    Snapshot(Snapshot&&) noexcept = default;
+    Snapshot& operator=(Snapshot&&) noexcept = default;
+
+    [[nodiscard]] std::span<const R> values() const noexcept {
+        return values_;
+    }
+    [[nodiscard]] std::size_t size() const noexcept { return values_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return values_.empty(); }
+    [[nodiscard]] const R& operator[](std::size_t i) const noexcept {
+        return values_[i];
+    }
+    [[nodiscard]] auto begin() const noexcept { return values_.begin(); }
+    [[nodiscard]] auto end() const noexcept { return values_.end(); }
+};
+
+#endif // REFINERY_HAS_MMAP
+
+} // namespace refinery
+
+#endif // REFINERY_SNAPSHOT_HPP
@@ -0,0 +1,310 @@
+// soa.hpp - Struct-of-arrays storage for records with refined members
+// Part of the C++26 Refinement Types Library
+//
+// RefinedSoA<Record> keeps one contiguous column per data member of Record,
+// found by reflection, so a scan over one field reads only that field:
+//
+//   struct Trade {
+//       IntervalRefined<int, 1, 200> venue;      // stored in one byte
+//       PositiveI32 quantity;
+//       PositiveF64 price;
+//   };
+//   RefinedSoA<Trade> trades;
+//   trades.push_back(trade);
+//   auto big = trades.filter<&Trade::quantity>([](int q) { return q > 500; });
+//   for (PositiveF64 p : trades.column<&Trade::price>()) ...
+//
+// Columns are addressed by member pointer. Integers refined by an integral
+// Interval are offset-coded into the narrowest unsigned type holding the
+// interval's width; other Refined members store their underlying value.
+// Refined values come back out through assume_valid, because every value
+// entered a column either as a Refined or through append, which validates
+// whole columns in one pass with the member checks of reflect.hpp.
+
+#ifndef REFINERY_SOA_HPP
+#define REFINERY_SOA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <meta>
+
+#include "reflect.hpp"
+
+namespace refinery {
+
+namespace detail {
+
+// How a member of type F is held in its column
+template <typename F> struct column_codec {
+    using storage_type = F;
+    using raw_type = F;
+
+    static constexpr const F& encode(const F& f) noexcept { return f; }
+    static constexpr const F& decode(const F& s) noexcept { return s; }
+    static constexpr const F& value(const F& s) noexcept { return s; }
+    static constexpr const F& wrap(const F& raw) noexcept { return raw; }
+};
+
+template <typename F>
+    requires is_refined<F>
+struct column_codec<F> {
+    using T = typename F::value_type;
+    using storage_type = T;
+    using raw_type = T;
+
+    static constexpr const T& encode(const F& f) noexcept { return f.get(); }
+    static constexpr F decode(const T& s) { return F(s, assume_valid); }
+    static constexpr const T& value(const T& s) noexcept { return s; }
+    static constexpr F wrap(const T& raw) { return F(raw, assume_valid); }
+};
+
+template <typename F>
+    requires is_refined<F> &&
+             coded_integral<typename F::value_type, F::predicate>
+struct column_codec<F> {
+    using T = typename F::value_type;
+    using code = interval_code<T, F::predicate>;
+    using storage_type = typename code::storage_type;
+    using raw_type = T;
+
+    static constexpr storage_type encode(const F& f) noexcept {
+        return code::encode(f.get());
+    }
+    static constexpr F decode(storage_type s) noexcept {
+        return F(code::decode(s), assume_valid);
+    }
+    static constexpr T value(storage_type s) noexcept {
+        return code::decode(s);
+    }
+    static constexpr F wrap(T raw) noexcept { return F(raw, assume_valid); }
+};
+
+// Index of the first raw value failing Member's checks, or raw.size().
+// Checks are AND-ed over blocks without branching, so passing columns run
+// at vector speed; only a failing block is rescanned.
+template <std::meta::info Member, typename Raw>
+std::size_t first_invalid(std::span<const Raw> raw) {
+    using codec = column_codec<field_type<Member>>;
+    if constexpr (!is_checked_field<Member>()) {
+        return raw.size();
+    } else {
+        constexpr std::size_t block = 64;
+        for (std::size_t i = 0; i < raw.size(); i += block) {
+            const std::size_t end = std::min(raw.size(), i + block);
+            bool ok = true;
+            for (std::size_t j = i; j < end; ++j)
+                ok &= check_value<Member>(codec::wrap(raw[j]));
+            if (ok)
+                continue;
+            for (std::size_t j = i; j < end; ++j) {
+                if (!check_value<Member>(codec::wrap(raw[j])))
+                    return j;
+            }
+        }
+        return raw.size();
+    }
+}
+
+template <typename S> consteval bool has_bit_fields() {
+    bool found = false;
+    template for (constexpr std::meta::info m : fields_of<S>()) {
+        found = found || std::meta::is_bit_field(m);
+    }
+    return found;
+}
+
+} // namespace detail
+
+// Records RefinedSoA can store: aggregates without bit-field members
+template <typename S>
+concept soa_record = std::is_class_v<S> && std::is_aggregate_v<S> &&
+                     !is_refined<S> && (!detail::has_bit_fields<S>());
+
+template <soa_record Record> class RefinedSoA {
+    static constexpr auto fields = detail::fields_of<Record>();
+    static constexpr std::size_t field_count = fields.size();
+
+    template <std::size_t I> using field_t = detail::field_type<fields[I]>;
+    template <std::size_t I> using codec = detail::column_codec<field_t<I>>;
+
+    template <std::size_t... I>
+    static auto make_columns(std::index_sequence<I...>)
+        -> std::tuple<std::vector<typename codec<I>::storage_type>...>;
+    using columns_type =
+        decltype(make_columns(std::make_index_sequence<field_count>{}));
+
+    template <auto Member> static consteval std::size_t index_of() {
+        return detail::member_index<Record, Member>();
+    }
+
+    template <auto Member>
+        requires(index_of<Member>() < field_count)
+    using member_t = field_t<index_of<Member>()>;
+
+    template <auto Member>
+    using member_codec = detail::column_codec<member_t<Member>>;
+
+    columns_type columns_;
+    std::size_t size_ = 0;
+
+    template <std::size_t... I>
+    void push_row(const Record& r, std::index_sequence<I...>) {
+        (std::get<I>(columns_).push_back(codec<I>::encode(r.[:fields[I]:])),
+         ...);
+    }
+
+    template <std::size_t... I>
+    Record make_row(std::size_t row, std::index_sequence<I...>) const {
+        return Record{codec<I>::decode(std::get<I>(columns_)[row])...};
+    }
+
+    template <std::size_t... I, typename... Columns>
+    std::optional<std::size_t> append_columns(std::index_sequence<I...>,
+                                              const Columns&... columns) {
+        const std::tuple raw{
+            std::span<const typename codec<I>::raw_type>(columns)...};
+        // Rows past the shortest column are incomplete, so the shortest
+        // length is itself a failing row when the lengths differ
+        const std::size_t n = std::min({std::get<I>(raw).size()...});
+        const bool ragged = ((std::get<I>(raw).size() != n) || ...);
+        std::size_t first = n;
+        ((first = std::min(first, detail::first_invalid<fields[I]>(
+                                      std::get<I>(raw).first(n)))),
+         ...);
+        if (first != n || ragged)
+            return first;
+        (std::ranges::transform(std::get<I>(raw),
+                                std::back_inserter(std::get<I>(columns_)),
+                                [](const auto& v) {
+                                    return codec<I>::encode(codec<I>::wrap(v));
+                                }),
+         ...);
+        size_ += n;
+        return std::nullopt;
+    }
+
+  public:
+    using record_type = Record;
+
+    // Column element type for Member (offset code, underlying value, or the
+    // member type itself)
+    template <auto Member>
+    using storage_type = typename member_codec<Member>::storage_type;
+
+    // Read-only view of one row
+    class row_ref {
+        const RefinedSoA* soa_;
+        std::size_t row_;
+
+      public:
+        constexpr row_ref(const RefinedSoA& soa, std::size_t row) noexcept
+            : soa_(&soa), row_(row) {}
+
+        template <auto Member> [[nodiscard]] auto get() const {
+            return soa_->template get<Member>(row_);
+        }
+        [[nodiscard]] Record record() const { return soa_->record(row_); }
+    };
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    void reserve(std::size_t n) {
+        std::apply([n](auto&... column) { (column.reserve(n), ...); },
+                   columns_);
+    }
+
+    void clear() noexcept {
+        std::apply([](auto&... column) { (column.clear(), ...); }, columns_);
+        size_ = 0;
+    }
+
+    // Append a record. Refined members are already valid, so nothing is
+    // checked.
+    void push_back(const Record& r) {
+        push_row(r, std::make_index_sequence<field_count>{});
+        ++size_;
+    }
+
+    // Validate and append rows given as one column per member, in
+    // declaration order, with raw values (T for a Refined<T, P> member).
+    // Returns the first row that fails a check, in which case nothing is
+    // appended; when the columns differ in length, the length of the
+    // shortest counts as a failing row.
+    template <typename... Columns>
+        requires(sizeof...(Columns) == field_count)
+    std::optional<std::size_t> append(const Columns&... columns) {
+        return append_columns(std::make_index_sequence<field_count>{},
+                              columns...);
+    }
+
+    [[nodiscard]] row_ref operator[](std::size_t row) const noexcept {
+        return row_ref(*this, row);
+    }
+
+    [[nodiscard]] Record record(std::size_t row) const {
+        return make_row(row, std::make_index_sequence<field_count>{});
+    }
+
+    template <auto Member> [[nodiscard]] auto get(std::size_t row) const {
+        using c = member_codec<Member>;
+        return c::decode(std::get<index_of<Member>()>(columns_)[row]);
+    }
+
+    // Replace one field; the value is already refined, so nothing is checked
+    template <auto Member>
+    void set(std::size_t row, const member_t<Member>& value) {
+        std::get<index_of<Member>()>(columns_)[row] =
+            member_codec<Member>::encode(value);
+    }
+
+    // The column for Member as stored
+    template <auto Member>
+    [[nodiscard]] std::span<const storage_type<Member>>
+    storage() const noexcept {
+        return std::get<index_of<Member>()>(columns_);
+    }
+
+    // The column for Member as a random-access range of member values
+    template <auto Member> [[nodiscard]] auto column() const noexcept {
+        return storage<Member>() |
+               std::views::transform([](const storage_type<Member>& s) {
+                   return member_codec<Member>::decode(s);
+               });
+    }
+
+    // Rows whose Member satisfies pred, which is given the underlying value
+    // (T for a Refined<T, P> member)
+    template <auto Member, typename Pred>
+    [[nodiscard]] std::vector<std::size_t> filter(Pred pred) const {
+        const auto values = storage<Member>();
+        std::vector<std::size_t> rows;
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            if (pred(member_codec<Member>::value(values[i])))
+                rows.push_back(i);
+        }
+        return rows;
+    }
+
+    // Number of rows whose Member satisfies pred, without branching per row
+    template <auto Member, typename Pred>
+    [[nodiscard]] std::size_t count_if(Pred pred) const {
+        std::size_t count = 0;
+        for (const auto& s : storage<Member>())
+            count += pred(member_codec<Member>::value(s)) ? 1 : 0;
+        return count;
+    }
+};
+
+} // namespace refinery
+
+#endif // REFINERY_SOA_HPP
@@ -0,0 +1,173 @@
+// span.hpp - Size refinements known at compile time, for spans and containers
+// Part of the C++26 Refinement Types Library
+//
+// SizeDivisibleBy<N> holds for spans and containers whose size() is a
+// multiple of N. A span refined with it can be walked in N-wide chunks
+// with no remainder loop, and each chunk is a std::span<T, N>, so the
+// per-chunk body has a constant trip count the compiler unrolls or turns
+// into straight vector code:
+//
+//   void scale(ChunkedSpan<float, 8> samples, float k) {
+//       for_each_chunk<8>(samples, [k](std::span<float, 8> chunk) {
+//           for (float& x : chunk)
+//               x *= k;
+//       });
+//   }
+//
+//   auto [body, tail] = split_chunks<8>(std::span(buffer)); // one modulo
+//   scale(body, 0.5f);
+//   for (float& x : tail)                                 // fewer than 8
+//       x *= 0.5f;
+//
+// chunk_subspan<N> takes a subspan that starts and ends on a chunk
+// boundary, as a ChunkedSpan<T, N>. A multiple of N converts implicitly to
+// a multiple of any divisor of N, and for_each_chunk<M> and
+// chunk_subspan<M> accept any such divisor M.
+//
+// FixedSize<N> pins the size exactly. Unlike SizeExactly(n) from
+// predicates.hpp, whose bound is captured at run time, N is part of the
+// type, so a refined container or span converts to std::span<T, N>
+// without a check or a copy, and kernels over it see a constant trip
+// count:
+//
+//   using Block = Refined<std::vector<float>, FixedSize<16>>;
+//   float trace(const Block& m) {
+//       std::span<const float, 16> a = fixed_span(m);  // no copy
+//       return a[0] + a[5] + a[10] + a[15];            // no size checks
+//   }
+//
+//   std::array<float, 16> identity = ...;
+//   FixedSpan<float, 16> view = refine_fixed(std::span(identity)); // no check
+
+#ifndef REFINERY_SPAN_HPP
+#define REFINERY_SPAN_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "refined_type.hpp"
+
+namespace refinery {
+
+namespace detail {
+
+template <std::size_t N> struct size_multiple {
+    static_assert(N > 0, "SizeDivisibleBy<0> is never satisfiable");
+    static constexpr std::size_t multiple = N;
+
+    template <typename C>
+    constexpr bool operator()(const C& c) const
+        requires requires { c.size(); }
+    {
+        return c.size() % N == 0;
+    }
+};
+
+template <std::size_t N> struct exact_size {
+    static constexpr std::size_t exact = N;
+
+    template <typename C>
+    constexpr bool operator()(const C& c) const
+        requires requires { c.size(); }
+    {
+        return c.size() == N;
+    }
+};
+
+// Element type seen through a refined contiguous container: const for
+// containers that own their elements, as the wrapper only hands out const
+// references, and as declared for views such as std::span
+template <typename C>
+using fixed_element_t = std::remove_reference_t<
+    decltype(*std::ranges::data(std::declval<const C&>()))>;
+
+} // namespace detail
+
+// True if the container size is a multiple of N
+template <std::size_t N>
+inline constexpr detail::size_multiple<N> SizeDivisibleBy{};
+
+template <typename T, std::size_t N>
+using ChunkedSpan = Refined<std::span<T>, SizeDivisibleBy<N>>;
+
+// True if the container size is exactly N
+template <std::size_t N> inline constexpr detail::exact_size<N> FixedSize{};
+
+template <typename T, std::size_t N>
+using FixedSpan = Refined<std::span<T>, FixedSize<N>>;
+
+// Multiple guaranteed by a predicate: N for SizeDivisibleBy<N> and
+// FixedSize<N>, else 1
+template <auto Pred>
+inline constexpr std::size_t size_multiple_of_v = [] {
+    if constexpr (detail::has_size_multiple<Pred>)
+        return decltype(Pred)::multiple;
+    else if constexpr (detail::has_exact_size<Pred>)
+        return decltype(Pred)::exact;
+    else
+        return std::size_t{1};
+}();
+
+// Call body(chunk) on each N-wide chunk of s in order, as std::span<T, N>
+template <std::size_t N, typename T, auto Pred, typename F>
+    requires(N > 0 && size_multiple_of_v<Pred> % N == 0)
+constexpr void for_each_chunk(const Refined<std::span<T>, Pred>& s, F&& body) {
+    T* p = s->data();
+    const std::size_t chunks = s->size() / N;
+    for (std::size_t c = 0; c < chunks; ++c)
+        body(std::span<T, N>(p + c * N, N));
+}
+
+// N-wide chunks [first, first + count) of s, refined as a multiple of N.
+// Only that is known of the subspan: a multiple of 16 cut into 8-wide
+// chunks may keep an odd number of them. Like std::span::subspan, the
+// chunks must lie within s.
+template <std::size_t N, typename T, auto Pred>
+    requires(N > 0 && size_multiple_of_v<Pred> % N == 0)
+[[nodiscard]] constexpr ChunkedSpan<T, N>
+chunk_subspan(const Refined<std::span<T>, Pred>& s, std::size_t first,
+              std::size_t count = std::dynamic_extent) noexcept {
+    const std::size_t offset = first * N;
+    const std::size_t length =
+        count == std::dynamic_extent ? s->size() - offset : count * N;
+    return ChunkedSpan<T, N>(s->subspan(offset, length), assume_valid);
+}
+
+// The longest prefix of s whose size is a multiple of N, refined, and the
+// remaining tail of fewer than N elements
+template <std::size_t N, typename T, std::size_t Extent>
+    requires(N > 0)
+[[nodiscard]] constexpr std::pair<ChunkedSpan<T, N>, std::span<T>>
+split_chunks(std::span<T, Extent> s) noexcept {
+    const std::size_t body = s.size() - s.size() % N;
+    return {ChunkedSpan<T, N>(std::span<T>(s.first(body)), assume_valid),
+            std::span<T>(s.subspan(body))};
+}
+
+// --- Fixed sizes ---
+
+// The elements of c as a fixed-extent span
+template <std::ranges::contiguous_range C, auto Pred>
+    requires detail::has_exact_size<Pred>
+[[nodiscard]] constexpr std::span<detail::fixed_element_t<C>,
+                                  decltype(Pred)::exact>
+fixed_span(const Refined<C, Pred>& c) noexcept {
+    constexpr std::size_t n = decltype(Pred)::exact;
+    return std::span<detail::fixed_element_t<C>, n>(std::ranges::data(*c), n);
+}
+
+// A fixed-extent span as FixedSpan; its size is already known
+template <typename T, std::size_t N>
+    requires(N != std::dynamic_extent)
+[[nodiscard]] constexpr FixedSpan<T, N>
+refine_fixed(std::span<T, N> s) noexcept {
+    return FixedSpan<T, N>(std::span<T>(s), assume_valid);
+}
+
+} // namespace refinery
+
+#endif // REFINERY_SPAN_HPP
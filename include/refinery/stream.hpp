@@ -0,0 +1,301 @@
+// stream.hpp - Sequence predicates checked incrementally over streamed chunks
+// Part of the C++26 Refinement Types Library
+//
+// Sequence predicates constrain a whole sequence rather than one value:
+//
+//   Sorted                     each element >= the one before it
+//   StrictlySorted             each element >  the one before it
+//   NoAdjacentDuplicates       each element != the one before it
+//   RunningSumWithin<Lo, Hi>{} every prefix sum lies in [Lo, Hi]
+//
+// They refine ranges directly, for data already in memory:
+//
+//   auto ids = try_refine<Refined<std::span<const int>, StrictlySorted>>(v);
+//
+// and, because each carries only O(1) state from one element to the next,
+// they can also be checked a chunk at a time as data arrives from a file,
+// pipe or socket, without materializing the stream:
+//
+//   StreamValidator<std::int64_t, Sorted> check;
+//   while (auto chunk = read_some())
+//       if (!check.feed(*chunk))
+//           break;                          // stop reading early
+//   if (auto n = check.finish())            // elements, all in order
+//       ...
+//   else
+//       report(n.error().index);            // first out-of-order element
+//
+// A failure that straddles two chunks (the last element of one and the
+// first of the next) is caught and reported at its stream index. When the
+// chunks were read into one buffer, finish(buffer, assume_valid) returns
+// the buffer as a Refined<std::span<const T>, Pred> without a second pass;
+// the tag is the caller's promise that buffer holds exactly what was fed.
+
+#ifndef REFINERY_STREAM_HPP
+#define REFINERY_STREAM_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <expected>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "refined_type.hpp"
+
+namespace refinery {
+
+// Error from a StreamValidator: index of the first element that broke the
+// predicate, counted from the start of the stream
+struct sequence_error {
+    std::size_t index;
+};
+
+// P is a sequence predicate over elements of type T: P::state<T> carries
+// what P needs between elements, step() checks one element and scan()
+// checks a chunk, returning the index of its first failing element
+template <typename P, typename T>
+concept sequence_predicate =
+    requires(typename P::template state<T> s, const T& v,
+             std::span<const T> chunk) {
+        { s.step(v) } -> std::convertible_to<bool>;
+        { s.scan(chunk) } -> std::same_as<std::size_t>;
+    };
+
+namespace detail {
+
+// Whole-range check shared by the sequence predicates
+template <typename P, std::ranges::input_range R>
+constexpr bool check_sequence(const R& range) {
+    using T = std::ranges::range_value_t<R>;
+    typename P::template state<T> s{};
+    if constexpr (std::ranges::contiguous_range<R>) {
+        std::span<const T> all(std::ranges::data(range),
+                               std::ranges::size(range));
+        return s.scan(all) == all.size();
+    } else {
+        for (const auto& v : range) {
+            if (!s.step(v))
+                return false;
+        }
+        return true;
+    }
+}
+
+// State for predicates on adjacent pairs: Rel(previous, current) must hold
+// for every pair, including the pair that spans two chunks
+template <typename T, typename Rel> struct adjacent_state {
+    std::optional<T> previous;
+
+    constexpr bool step(const T& v) {
+        bool ok = !previous || Rel{}(*previous, v);
+        previous = v;
+        return ok;
+    }
+
+    // Compares pairs a block at a time without branching, so the common
+    // all-valid case vectorizes; a failing block is rescanned to locate it
+    constexpr std::size_t scan(std::span<const T> chunk) {
+        if (chunk.empty())
+            return 0;
+        if (previous && !Rel{}(*previous, chunk[0]))
+            return 0;
+        constexpr std::size_t block = 64;
+        for (std::size_t i = 1; i < chunk.size(); i += block) {
+            const std::size_t end = std::min(chunk.size(), i + block);
+            bool ok = true;
+            for (std::size_t j = i; j < end; ++j)
+                ok &= static_cast<bool>(Rel{}(chunk[j - 1], chunk[j]));
+            if (ok)
+                continue;
+            for (std::size_t j = i; j < end; ++j) {
+                if (!Rel{}(chunk[j - 1], chunk[j]))
+                    return j;
+            }
+        }
+        previous = chunk.back();
+        return chunk.size();
+    }
+};
+
+// Elementwise scan for states whose steps depend on each other
+template <typename State, typename T>
+constexpr std::size_t scan_by_step(State& s, std::span<const T> chunk) {
+    for (std::size_t i = 0; i < chunk.size(); ++i) {
+        if (!s.step(chunk[i]))
+            return i;
+    }
+    return chunk.size();
+}
+
+template <typename Rel> struct adjacent_predicate {
+    template <typename T> using state = adjacent_state<T, Rel>;
+
+    template <std::ranges::input_range R>
+    constexpr bool operator()(const R& range) const {
+        return check_sequence<adjacent_predicate>(range);
+    }
+};
+
+struct not_greater {
+    template <typename T>
+    constexpr bool operator()(const T& a, const T& b) const {
+        return !(b < a);
+    }
+};
+
+struct less {
+    template <typename T>
+    constexpr bool operator()(const T& a, const T& b) const {
+        return a < b;
+    }
+};
+
+struct not_equal {
+    template <typename T>
+    constexpr bool operator()(const T& a, const T& b) const {
+        return !(a == b);
+    }
+};
+
+} // namespace detail
+
+// --- Sequence predicates ---
+
+// True if the sequence is non-decreasing
+inline constexpr detail::adjacent_predicate<detail::not_greater> Sorted{};
+
+// True if the sequence is strictly increasing
+inline constexpr detail::adjacent_predicate<detail::less> StrictlySorted{};
+
+// True if no two consecutive elements are equal
+inline constexpr detail::adjacent_predicate<detail::not_equal>
+    NoAdjacentDuplicates{};
+
+namespace traits {
+
+// A strictly increasing sequence is non-decreasing and has no equal
+// neighbours
+template <> struct implies<StrictlySorted, Sorted> {
+    static constexpr bool value = true;
+};
+template <> struct implies<StrictlySorted, NoAdjacentDuplicates> {
+    static constexpr bool value = true;
+};
+
+} // namespace traits
+
+namespace detail {
+
+// Type of a running sum of T checked against bounds of types L and H: their
+// common type, kept signed for signed elements so that an unsigned bound
+// does not turn negative elements into huge ones
+template <typename T, typename L, typename H,
+          typename C = std::common_type_t<T, L, H>>
+using running_sum_t =
+    typename std::conditional_t<std::integral<C> && std::signed_integral<T>,
+                                std::make_signed<C>,
+                                std::type_identity<C>>::type;
+
+} // namespace detail
+
+// True if every prefix sum lies in [Lo, Hi] (the empty prefix is not
+// checked). Integer sums that overflow fail rather than wrap, and are
+// compared with the bounds by value, whatever their signedness.
+template <auto Lo, auto Hi> struct RunningSumWithin {
+    static constexpr auto lo = Lo;
+    static constexpr auto hi = Hi;
+
+    template <typename T> struct state {
+        using sum_type =
+            detail::running_sum_t<T, decltype(Lo), decltype(Hi)>;
+        sum_type sum{};
+
+        constexpr bool step(const T& v) {
+            if constexpr (std::integral<sum_type>) {
+                if (__builtin_add_overflow(sum, static_cast<sum_type>(v),
+                                           &sum))
+                    return false;
+                return std::cmp_greater_equal(sum, Lo) &&
+                       std::cmp_less_equal(sum, Hi);
+            } else {
+                sum += static_cast<sum_type>(v);
+                return sum >= Lo && sum <= Hi;
+            }
+        }
+
+        constexpr std::size_t scan(std::span<const T> chunk) {
+            return detail::scan_by_step(*this, chunk);
+        }
+    };
+
+    template <std::ranges::input_range R>
+    constexpr bool operator()(const R& range) const {
+        return detail::check_sequence<RunningSumWithin>(range);
+    }
+};
+
+// --- Incremental validation ---
+
+template <typename T, auto Pred>
+    requires sequence_predicate<decltype(Pred), T>
+class StreamValidator {
+    typename decltype(Pred)::template state<T> state_{};
+    std::size_t consumed_ = 0;
+    std::optional<std::size_t> failure_;
+
+  public:
+    using value_type = T;
+    using view_type = Refined<std::span<const T>, Pred>;
+
+    // Check the next chunk of the stream. Returns false once any element
+    // so far has failed; chunks fed after that are ignored.
+    constexpr bool feed(std::span<const T> chunk) {
+        if (failure_)
+            return false;
+        std::size_t good = state_.scan(chunk);
+        consumed_ += good;
+        if (good != chunk.size()) {
+            failure_ = consumed_;
+            return false;
+        }
+        return true;
+    }
+
+    [[nodiscard]] constexpr bool ok() const noexcept { return !failure_; }
+
+    // Elements checked and found valid so far
+    [[nodiscard]] constexpr std::size_t consumed() const noexcept {
+        return consumed_;
+    }
+
+    // End of the stream: the number of elements, or the first failure
+    [[nodiscard]] constexpr std::expected<std::size_t, sequence_error>
+    finish() const noexcept {
+        if (failure_)
+            return std::unexpected(sequence_error{*failure_});
+        return consumed_;
+    }
+
+    // End of a stream whose chunks were read, in order, into `fed`: the
+    // whole buffer as a refined view, with no second pass. The contents of
+    // `fed` are not compared with what was fed, hence the assume_valid
+    // tag; only its size is, and a mismatch is reported as an error at
+    // consumed().
+    [[nodiscard]] constexpr std::expected<view_type, sequence_error>
+    finish(std::span<const T> fed, assume_valid_t) const noexcept {
+        if (failure_)
+            return std::unexpected(sequence_error{*failure_});
+        if (fed.size() != consumed_)
+            return std::unexpected(sequence_error{consumed_});
+        return view_type(fed, assume_valid);
+    }
+};
+
+} // namespace refinery
+
+#endif // REFINERY_STREAM_HPP
@@ -0,0 +1,279 @@
+// tabulated.hpp - Lookup-table evaluation of predicates over narrow types
+// Part of the C++26 Refinement Types Library
+//
+// Any predicate over an 8- or 16-bit integral domain can be evaluated for
+// every possible input at compile time. Tabulated<Pred, T> stores the result
+// as a bitset (256 bits for 8-bit T, 64K bits for 16-bit T), so a runtime
+// check is a single load-and-test no matter how complex Pred is:
+//
+//   constexpr auto IdentChar =
+//       Any<InRange('a', 'z'), InRange('0', '9'), EqualTo('_')>;
+//   using Ident = Refined<char, Tabulated<IdentChar, char>>;
+//
+// For 8-bit types the table is also laid out as two 16-entry nibble bitmaps,
+// which lets all_of()/find_invalid() classify 16 (SSSE3) or 32 (AVX2) bytes
+// per iteration with pshufb.
+
+#ifndef REFINERY_TABULATED_HPP
+#define REFINERY_TABULATED_HPP
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#include "interval.hpp"
+#include "refined_type.hpp"
+
+#if defined(__SSSE3__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace refinery {
+
+// Integral types whose whole domain fits in a 64K-bit table
+template <typename T>
+concept tabulatable =
+    std::integral<T> && !std::same_as<T, bool> && sizeof(T) <= 2;
+
+// Structural predicate backed by a compile-time truth table for Pred.
+// Valid as NTTP because it has no data members (the table is static).
+template <auto Pred, typename T>
+    requires tabulatable<T> && predicate_for<decltype(Pred), T>
+struct TabulatedPredicate {
+    using value_type = T;
+    static constexpr auto underlying = Pred;
+
+  private:
+    using index_type = std::make_unsigned_t<T>;
+
+    static constexpr std::size_t domain_size = std::size_t{1}
+                                               << (8 * sizeof(T));
+    static constexpr std::size_t word_count = domain_size / 64;
+
+    static consteval std::array<std::uint64_t, word_count> build_table() {
+        std::array<std::uint64_t, word_count> words{};
+        for (std::size_t i = 0; i < domain_size; ++i) {
+            if (Pred(static_cast<T>(i)))
+                words[i / 64] |= std::uint64_t{1} << (i % 64);
+        }
+        return words;
+    }
+
+    // Nibble bitmaps for the pshufb kernel: bitmap[lo] has bit (hi & 7) set
+    // when the byte (hi << 4 | lo) satisfies Pred. Bytes with hi < 8 live in
+    // the first bitmap, bytes with hi >= 8 in the second.
+    static consteval std::array<std::uint8_t, 32> build_nibble_bitmaps() {
+        std::array<std::uint8_t, 32> maps{};
+        if constexpr (sizeof(T) == 1) {
+            for (std::size_t i = 0; i < 256; ++i) {
+                if (Pred(static_cast<T>(i))) {
+                    std::size_t hi = i >> 4;
+                    std::size_t lo = i & 0x0f;
+                    maps[(hi < 8 ? 0 : 16) + lo] |=
+                        static_cast<std::uint8_t>(1u << (hi & 7));
+                }
+            }
+        }
+        return maps;
+    }
+
+  public:
+    static constexpr std::array<std::uint64_t, word_count> table =
+        build_table();
+    static constexpr std::array<std::uint8_t, 32> nibble_bitmaps =
+        build_nibble_bitmaps();
+
+    constexpr bool operator()(T v) const noexcept {
+        auto i = static_cast<index_type>(v);
+        return ((table[i / 64] >> (i % 64)) & 1u) != 0;
+    }
+
+    // Index of the first element that fails Pred, or values.size()
+    static constexpr std::size_t
+    find_invalid(std::span<const T> values) noexcept;
+
+    // True if every element satisfies Pred
+    static constexpr bool all_of(std::span<const T> values) noexcept {
+        return find_invalid(values) == values.size();
+    }
+};
+
+// Lookup-table adaptor: Tabulated<Pred, T> accepts exactly the T values that
+// Pred accepts.
+template <auto Pred, typename T>
+inline constexpr TabulatedPredicate<Pred, T> Tabulated{};
+
+// Trait to detect tabulated predicates
+namespace traits {
+
+template <typename T> struct tabulated_traits : std::false_type {};
+
+template <typename T>
+    requires requires {
+        T::underlying;
+        typename T::value_type;
+    } && std::same_as<T, TabulatedPredicate<T::underlying,
+                                            typename T::value_type>>
+struct tabulated_traits<T> : std::true_type {
+    static constexpr auto underlying = T::underlying;
+};
+
+} // namespace traits
+
+// Concept for tabulated predicates (takes an NTTP predicate value)
+template <auto Pred>
+concept tabulated_predicate =
+    traits::tabulated_traits<std::remove_cv_t<decltype(Pred)>>::value;
+
+namespace detail {
+
+// Scalar fallback shared by all widths
+template <typename T, typename Table>
+constexpr std::size_t find_invalid_scalar(std::span<const T> values,
+                                          std::size_t start,
+                                          const Table& table) noexcept {
+    using U = std::make_unsigned_t<T>;
+    for (std::size_t i = start; i < values.size(); ++i) {
+        auto idx = static_cast<U>(values[i]);
+        if (((table[idx / 64] >> (idx % 64)) & 1u) == 0)
+            return i;
+    }
+    return values.size();
+}
+
+#if defined(__AVX2__)
+
+// Classify 32 bytes: returns a bitmask with bit i set when byte i is valid
+inline std::uint32_t classify32(__m256i bytes, __m256i map_lo,
+                                __m256i map_hi) noexcept {
+    const __m256i low_mask = _mm256_set1_epi8(static_cast<char>(0x8f));
+    const __m256i flip = _mm256_set1_epi8(static_cast<char>(0x80));
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    const __m256i bit_select =
+        _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64,
+                         -128, 1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16,
+                         32, 64, -128);
+
+    __m256i row = _mm256_or_si256(
+        _mm256_shuffle_epi8(map_lo, _mm256_and_si256(bytes, low_mask)),
+        _mm256_shuffle_epi8(
+            map_hi,
+            _mm256_and_si256(_mm256_xor_si256(bytes, flip), low_mask)));
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibble);
+    __m256i bit = _mm256_shuffle_epi8(bit_select, hi);
+    __m256i hit = _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit);
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(hit));
+}
+
+#endif
+
+#if defined(__SSSE3__)
+
+// Classify 16 bytes: returns a bitmask with bit i set when byte i is valid
+inline std::uint32_t classify16(__m128i bytes, __m128i map_lo,
+                                __m128i map_hi) noexcept {
+    const __m128i low_mask = _mm_set1_epi8(static_cast<char>(0x8f));
+    const __m128i flip = _mm_set1_epi8(static_cast<char>(0x80));
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    const __m128i bit_select =
+        _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64,
+                      -128);
+
+    __m128i row = _mm_or_si128(
+        _mm_shuffle_epi8(map_lo, _mm_and_si128(bytes, low_mask)),
+        _mm_shuffle_epi8(map_hi,
+                         _mm_and_si128(_mm_xor_si128(bytes, flip), low_mask)));
+    __m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble);
+    __m128i bit = _mm_shuffle_epi8(bit_select, hi);
+    __m128i hit = _mm_cmpeq_epi8(_mm_and_si128(row, bit), bit);
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(hit));
+}
+
+#endif
+
+// Vectorized search for the first byte whose nibble-bitmap bit is clear.
+// Returns the index where the scalar tail should resume if no invalid byte
+// was found in the vectorized prefix.
+template <typename T>
+inline std::size_t find_invalid_bytes(std::span<const T> values,
+                                      const std::uint8_t* maps,
+                                      std::size_t& resume) noexcept {
+    static_assert(sizeof(T) == 1);
+    const auto* data = reinterpret_cast<const std::uint8_t*>(values.data());
+    const std::size_t n = values.size();
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i map_lo = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(maps)));
+    const __m256i map_hi = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(maps + 16)));
+    for (; i + 32 <= n; i += 32) {
+        __m256i bytes =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        std::uint32_t valid = classify32(bytes, map_lo, map_hi);
+        if (valid != 0xffffffffu)
+            return i + static_cast<std::size_t>(std::countr_one(valid));
+    }
+#endif
+#if defined(__SSSE3__)
+    const __m128i map_lo16 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(maps));
+    const __m128i map_hi16 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(maps + 16));
+    for (; i + 16 <= n; i += 16) {
+        __m128i bytes =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        std::uint32_t valid = classify16(bytes, map_lo16, map_hi16);
+        if (valid != 0xffffu)
+            return i + static_cast<std::size_t>(std::countr_one(valid));
+    }
+#else
+    (void)data;
+    (void)maps;
+#endif
+    resume = i;
+    return n;
+}
+
+} // namespace detail
+
+template <auto Pred, typename T>
+    requires tabulatable<T> && predicate_for<decltype(Pred), T>
+constexpr std::size_t TabulatedPredicate<Pred, T>::find_invalid(
+    std::span<const T> values) noexcept {
+    std::size_t start = 0;
+    if constexpr (sizeof(T) == 1) {
+        if !consteval {
+            std::size_t hit = detail::find_invalid_bytes(
+                values, nibble_bitmaps.data(), start);
+            if (hit != values.size())
+                return hit;
+        }
+    }
+    return detail::find_invalid_scalar(values, start, table);
+}
+
+// Tabulate Pred when T is narrow enough and Pred is not already a plain
+// range check (interval predicates compile to two compares and keep their
+// interval arithmetic); otherwise return Pred unchanged.
+template <auto Pred, typename T> consteval auto tabulate_if_narrow() {
+    if constexpr (tabulatable<T> && !interval_predicate<Pred> &&
+                  !tabulated_predicate<Pred>) {
+        return Tabulated<Pred, T>;
+    } else {
+        return Pred;
+    }
+}
+
+// Automatic opt-in: Refined<T, Tabulated<Pred, T>> for 8/16-bit T,
+// Refined<T, Pred> otherwise.
+template <typename T, auto Pred>
+using TabulatedRefined = Refined<T, tabulate_if_narrow<Pred, T>()>;
+
+} // namespace refinery
+
+#endif // REFINERY_TABULATED_HPP
@@ -0,0 +1,452 @@
+// text.hpp - String predicates with vectorized kernels
+// Part of the C++26 Refinement Types Library
+//
+// Byte-level predicates for std::string / std::string_view:
+//
+//   Ascii             every byte < 0x80
+//   NoNul             no '\0' byte
+//   ValidUtf8         well-formed UTF-8 (no overlongs, surrogates, > U+10FFFF)
+//   CharsIn<Class>    every byte satisfies the character class Class
+//
+// At runtime the checks process 32 (SSE2) or 64 (AVX2) bytes per iteration
+// for Ascii/NoNul, 16/32 bytes for ValidUtf8 (Keiser-Lemire lookup
+// algorithm) and CharsIn (pshufb nibble lookup, see tabulated.hpp). During
+// constant evaluation they fall back to scalar loops, so
+// Refined<std::string_view, Ascii> can still be verified at compile time.
+
+#ifndef REFINERY_TEXT_HPP
+#define REFINERY_TEXT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include "compose.hpp"
+#include "predicates.hpp"
+#include "tabulated.hpp"
+
+#if defined(__SSE2__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace refinery {
+
+// --- Character classes (byte predicates, for use with CharsIn) ---
+
+// True if c is '0'-'9'
+inline constexpr auto IsDigit = [](auto c) constexpr {
+    return c >= '0' && c <= '9';
+};
+
+// True if c is 'A'-'Z'
+inline constexpr auto IsUpper = [](auto c) constexpr {
+    return c >= 'A' && c <= 'Z';
+};
+
+// True if c is 'a'-'z'
+inline constexpr auto IsLower = [](auto c) constexpr {
+    return c >= 'a' && c <= 'z';
+};
+
+// True if c is an ASCII letter
+inline constexpr auto IsAlpha = Any<IsUpper, IsLower>;
+
+// True if c is an ASCII letter or digit
+inline constexpr auto IsAlnum = Any<IsAlpha, IsDigit>;
+
+// True if c is a hexadecimal digit
+inline constexpr auto IsHexDigit =
+    Any<IsDigit, InRange('a', 'f'), InRange('A', 'F')>;
+
+// True if c is ' ', '\t', '\n', '\v', '\f' or '\r'
+inline constexpr auto IsSpace = [](auto c) constexpr {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+};
+
+// True if c is a printable ASCII character (0x20-0x7E)
+inline constexpr auto IsPrint = [](auto c) constexpr {
+    return c >= ' ' && c <= '~';
+};
+
+namespace detail {
+
+// --- Scalar reference implementations (also used in constant evaluation) ---
+
+constexpr bool ascii_scalar(std::string_view s) noexcept {
+    for (char c : s) {
+        if (static_cast<unsigned char>(c) >= 0x80)
+            return false;
+    }
+    return true;
+}
+
+constexpr bool no_nul_scalar(std::string_view s) noexcept {
+    for (char c : s) {
+        if (c == '\0')
+            return false;
+    }
+    return true;
+}
+
+constexpr bool utf8_scalar(std::string_view s) noexcept {
+    const std::size_t n = s.size();
+    std::size_t i = 0;
+    auto byte = [&](std::size_t k) {
+        return static_cast<unsigned char>(s[k]);
+    };
+    auto cont = [&](std::size_t k) {
+        return k < n && (byte(k) & 0xc0) == 0x80;
+    };
+    while (i < n) {
+        unsigned char c = byte(i);
+        if (c < 0x80) {
+            ++i;
+        } else if (c >= 0xc2 && c <= 0xdf) {
+            if (!cont(i + 1))
+                return false;
+            i += 2;
+        } else if (c >= 0xe0 && c <= 0xef) {
+            if (!cont(i + 1) || !cont(i + 2))
+                return false;
+            unsigned char c1 = byte(i + 1);
+            if ((c == 0xe0 && c1 < 0xa0) || (c == 0xed && c1 > 0x9f))
+                return false; // overlong / surrogate
+            i += 3;
+        } else if (c >= 0xf0 && c <= 0xf4) {
+            if (!cont(i + 1) || !cont(i + 2) || !cont(i + 3))
+                return false;
+            unsigned char c1 = byte(i + 1);
+            if ((c == 0xf0 && c1 < 0x90) || (c == 0xf4 && c1 > 0x8f))
+                return false; // overlong / above U+10FFFF
+            i += 4;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// --- Vectorized kernels ---
+
+inline bool ascii_simd(std::string_view s) noexcept {
+    const char* p = s.data();
+    std::size_t n = s.size();
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 64 <= n; i += 64) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        __m256i b =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 32));
+        if (_mm256_movemask_epi8(_mm256_or_si256(a, b)) != 0)
+            return false;
+    }
+#endif
+#if defined(__SSE2__)
+    for (; i + 32 <= n; i += 32) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        __m128i b =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 16));
+        if (_mm_movemask_epi8(_mm_or_si128(a, b)) != 0)
+            return false;
+    }
+#endif
+    // Tail: 8 bytes at a time, then single bytes
+    for (; i + 8 <= n; i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, p + i, 8);
+        if ((word & 0x8080808080808080ull) != 0)
+            return false;
+    }
+    return ascii_scalar(s.substr(i));
+}
+
+inline bool no_nul_simd(std::string_view s) noexcept {
+    const char* p = s.data();
+    std::size_t n = s.size();
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i zero32 = _mm256_setzero_si256();
+    for (; i + 64 <= n; i += 64) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        __m256i b =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 32));
+        __m256i z = _mm256_or_si256(_mm256_cmpeq_epi8(a, zero32),
+                                    _mm256_cmpeq_epi8(b, zero32));
+        if (_mm256_movemask_epi8(z) != 0)
+            return false;
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i zero16 = _mm_setzero_si128();
+    for (; i + 32 <= n; i += 32) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        __m128i b =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 16));
+        __m128i z = _mm_or_si128(_mm_cmpeq_epi8(a, zero16),
+                                 _mm_cmpeq_epi8(b, zero16));
+        if (_mm_movemask_epi8(z) != 0)
+            return false;
+    }
+#endif
+    return std::memchr(p + i, '\0', n - i) == nullptr;
+}
+
+// UTF-8 validation after Keiser & Lemire, "Validating UTF-8 In Less Than
+// One Instruction Per Byte" (2021). Each byte is classified by three 16-entry
+// lookups (high nibble of the previous byte, low nibble of the previous
+// byte, high nibble of the current byte); their AND is non-zero exactly
+// where a two-byte error pattern occurs. 3- and 4-byte sequences are then
+// checked by requiring continuation bytes where prev2/prev3 were leads.
+namespace utf8 {
+
+inline constexpr std::uint8_t too_short = 1 << 0;
+inline constexpr std::uint8_t too_long = 1 << 1;
+inline constexpr std::uint8_t overlong_3 = 1 << 2;
+inline constexpr std::uint8_t too_large = 1 << 3;
+inline constexpr std::uint8_t surrogate = 1 << 4;
+inline constexpr std::uint8_t overlong_2 = 1 << 5;
+inline constexpr std::uint8_t too_large_1000 = 1 << 6;
+inline constexpr std::uint8_t overlong_4 = 1 << 6;
+inline constexpr std::uint8_t two_conts = 1 << 7;
+inline constexpr std::uint8_t carry = too_short | too_long | two_conts;
+
+// Indexed by the high nibble of the previous byte
+alignas(16) inline constexpr std::uint8_t byte_1_high[16] = {
+    too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+    too_long, two_conts, two_conts, two_conts, two_conts,
+    too_short | overlong_2, too_short, too_short | overlong_3 | surrogate,
+    too_short | too_large | too_large_1000 | overlong_4};
+
+// Indexed by the low nibble of the previous byte
+alignas(16) inline constexpr std::uint8_t byte_1_low[16] = {
+    carry | overlong_3 | overlong_2 | overlong_4,
+    carry | overlong_2,
+    carry,
+    carry,
+    carry | too_large,
+    carry | too_large | too_large_1000,
+    carry | too_large | too_large_1000,
+    carry | too_large | too_large_1000,
+    carry | too_large | too_large_1000,
+    carry | too_large | too_large_1000,
+    carry | too_large | too_large_1000,
+    carry | too_large | too_large_1000,
+    carry | too_large | too_large_1000,
+    carry | too_large | too_large_1000 | surrogate,
+    carry | too_large | too_large_1000,
+    carry | too_large | too_large_1000};
+
+// Indexed by the high nibble of the current byte
+alignas(16) inline constexpr std::uint8_t byte_2_high[16] = {
+    too_short, too_short, too_short, too_short, too_short, too_short,
+    too_short, too_short,
+    too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 |
+        overlong_4,
+    too_long | overlong_2 | two_conts | overlong_3 | too_large,
+    too_long | overlong_2 | two_conts | surrogate | too_large,
+    too_long | overlong_2 | two_conts | surrogate | too_large, too_short,
+    too_short, too_short, too_short};
+
+// Thresholds for an incomplete sequence at the end of a block: the last
+// three bytes must not be leads of sequences longer than what remains
+alignas(16) inline constexpr std::uint8_t incomplete_max[32] = {
+    255, 255, 255, 255, 255, 255, 255, 255, 255,      255,      255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255,      255,      255,
+    255, 255, 255, 255, 255, 255, 255, 0xf0 - 1, 0xe0 - 1, 0xc0 - 1};
+
+} // namespace utf8
+
+#if defined(__AVX2__)
+
+inline bool utf8_simd(std::string_view s) noexcept {
+    using namespace utf8;
+    const __m256i t1h = _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<const __m128i*>(byte_1_high)));
+    const __m256i t1l = _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<const __m128i*>(byte_1_low)));
+    const __m256i t2h = _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<const __m128i*>(byte_2_high)));
+    const __m256i max_tail = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(incomplete_max));
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+
+    __m256i error = _mm256_setzero_si256();
+    __m256i prev_block = _mm256_setzero_si256();
+    __m256i prev_incomplete = _mm256_setzero_si256();
+
+    auto check_block = [&](__m256i input) {
+        if (_mm256_movemask_epi8(input) == 0) {
+            // ASCII block: only a dangling sequence from before can fail
+            error = _mm256_or_si256(error, prev_incomplete);
+            prev_incomplete = _mm256_setzero_si256();
+            prev_block = input;
+            return;
+        }
+        // prev<N>: input shifted right by N bytes, filled from prev_block
+        __m256i carried = _mm256_permute2x128_si256(prev_block, input, 0x21);
+        __m256i prev1 = _mm256_alignr_epi8(input, carried, 16 - 1);
+        __m256i prev2 = _mm256_alignr_epi8(input, carried, 16 - 2);
+        __m256i prev3 = _mm256_alignr_epi8(input, carried, 16 - 3);
+
+        __m256i b1h = _mm256_shuffle_epi8(
+            t1h, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+        __m256i b1l =
+            _mm256_shuffle_epi8(t1l, _mm256_and_si256(prev1, nibble));
+        __m256i b2h = _mm256_shuffle_epi8(
+            t2h, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+        __m256i special = _mm256_and_si256(_mm256_and_si256(b1h, b1l), b2h);
+
+        __m256i third = _mm256_subs_epu8(
+            prev2, _mm256_set1_epi8(static_cast<char>(0xe0 - 0x80)));
+        __m256i fourth = _mm256_subs_epu8(
+            prev3, _mm256_set1_epi8(static_cast<char>(0xf0 - 0x80)));
+        __m256i must23 = _mm256_and_si256(
+            _mm256_or_si256(third, fourth),
+            _mm256_set1_epi8(static_cast<char>(0x80)));
+
+        error = _mm256_or_si256(error, _mm256_xor_si256(must23, special));
+        prev_incomplete = _mm256_subs_epu8(input, max_tail);
+        prev_block = input;
+    };
+
+    const char* p = s.data();
+    std::size_t n = s.size();
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        check_block(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)));
+        // Bail out early on long invalid inputs
+        if ((i & 1023) == 0 && !_mm256_testz_si256(error, error))
+            return false;
+    }
+    if (i < n) {
+        alignas(32) char tail[32] = {};
+        std::memcpy(tail, p + i, n - i);
+        check_block(_mm256_load_si256(reinterpret_cast<const __m256i*>(tail)));
+    }
+    error = _mm256_or_si256(error, prev_incomplete);
+    return _mm256_testz_si256(error, error) != 0;
+}
+
+#elif defined(__SSSE3__)
+
+inline bool utf8_simd(std::string_view s) noexcept {
+    using namespace utf8;
+    const __m128i t1h =
+        _mm_load_si128(reinterpret_cast<const __m128i*>(byte_1_high));
+    const __m128i t1l =
+        _mm_load_si128(reinterpret_cast<const __m128i*>(byte_1_low));
+    const __m128i t2h =
+        _mm_load_si128(reinterpret_cast<const __m128i*>(byte_2_high));
+    const __m128i max_tail =
+        _mm_load_si128(reinterpret_cast<const __m128i*>(incomplete_max + 16));
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+
+    __m128i error = _mm_setzero_si128();
+    __m128i prev_block = _mm_setzero_si128();
+    __m128i prev_incomplete = _mm_setzero_si128();
+
+    auto check_block = [&](__m128i input) {
+        if (_mm_movemask_epi8(input) == 0) {
+            error = _mm_or_si128(error, prev_incomplete);
+            prev_incomplete = _mm_setzero_si128();
+            prev_block = input;
+            return;
+        }
+        __m128i prev1 = _mm_alignr_epi8(input, prev_block, 16 - 1);
+        __m128i prev2 = _mm_alignr_epi8(input, prev_block, 16 - 2);
+        __m128i prev3 = _mm_alignr_epi8(input, prev_block, 16 - 3);
+
+        __m128i b1h = _mm_shuffle_epi8(
+            t1h, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+        __m128i b1l = _mm_shuffle_epi8(t1l, _mm_and_si128(prev1, nibble));
+        __m128i b2h = _mm_shuffle_epi8(
+            t2h, _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+        __m128i special = _mm_and_si128(_mm_and_si128(b1h, b1l), b2h);
+
+        __m128i third = _mm_subs_epu8(
+            prev2, _mm_set1_epi8(static_cast<char>(0xe0 - 0x80)));
+        __m128i fourth = _mm_subs_epu8(
+            prev3, _mm_set1_epi8(static_cast<char>(0xf0 - 0x80)));
+        __m128i must23 =
+            _mm_and_si128(_mm_or_si128(third, fourth),
+                          _mm_set1_epi8(static_cast<char>(0x80)));
+
+        error = _mm_or_si128(error, _mm_xor_si128(must23, special));
+        prev_incomplete = _mm_subs_epu8(input, max_tail);
+        prev_block = input;
+    };
+
+    const char* p = s.data();
+    std::size_t n = s.size();
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+        check_block(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)));
+    if (i < n) {
+        alignas(16) char tail[16] = {};
+        std::memcpy(tail, p + i, n - i);
+        check_block(_mm_load_si128(reinterpret_cast<const __m128i*>(tail)));
+    }
+    error = _mm_or_si128(error, prev_incomplete);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) ==
+           0xffff;
+}
+
+#else
+
+inline bool utf8_simd(std::string_view s) noexcept {
+    // Skip the ASCII prefix 8 bytes at a time, then validate the rest
+    std::size_t i = 0;
+    for (; i + 8 <= s.size(); i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, s.data() + i, 8);
+        if ((word & 0x8080808080808080ull) != 0)
+            break;
+    }
+    return utf8_scalar(s.substr(i));
+}
+
+#endif
+
+} // namespace detail
+
+// --- String predicates ---
+
+// True if every byte is 7-bit ASCII
+inline constexpr auto Ascii = [](std::string_view s) constexpr {
+    if consteval {
+        return detail::ascii_scalar(s);
+    } else {
+        return detail::ascii_simd(s);
+    }
+};
+
+// True if the string contains no NUL byte (safe to pass as a C string)
+inline constexpr auto NoNul = [](std::string_view s) constexpr {
+    if consteval {
+        return detail::no_nul_scalar(s);
+    } else {
+        return detail::no_nul_simd(s);
+    }
+};
+
+// True if the string is well-formed UTF-8
+inline constexpr auto ValidUtf8 = [](std::string_view s) constexpr {
+    if consteval {
+        return detail::utf8_scalar(s);
+    } else {
+        return detail::utf8_simd(s);
+    }
+};
+
+// True if every byte satisfies the character class Class, e.g.
+// CharsIn<IsDigit>, CharsIn<IsHexDigit>, CharsIn<Any<IsAlnum, EqualTo('_')>>
+template <auto Class>
+inline constexpr auto CharsIn = [](std::string_view s) constexpr {
+    return Tabulated<Class, char>.all_of(s);
+};
+
+} // namespace refinery
+
+#endif // REFINERY_TEXT_HPP
@@ -0,0 +1,204 @@
+// wire.hpp - Framed wire format for refined records between services
+// Part of the C++26 Refinement Types Library
+//
+// encode_frame<S> packs records into a frame tagged with a schema
+// fingerprint; decode_frame<S> unpacks one, either re-validating every
+// member or, for a peer configured as trusted, skipping the checks:
+//
+//   std::vector<std::byte> frame;
+//   encode_frame<Quote>(quotes, frame);               // sender
+//   send(socket, frame);
+//
+//   std::vector<Quote> received;                      // receiver
+//   auto used = decode_frame<Quote>(bytes, peer.trust, received);
+//   if (!used)
+//       drop_peer(used.error());                      // schema or content
+//
+// A frame is a 16-byte little-endian header (schema fingerprint, record
+// count, record size) followed by the records in the layout of decode.hpp:
+// members in declaration order, no padding, in byte order Order.
+//
+// The schema fingerprint hashes, via reflection, each member's name, its
+// type (a Refined member's type names its predicate, and a lambda
+// predicate is located by where it is written, as in type_fingerprint)
+// and its annotations, along with Order. Sender and receiver only agree
+// on it if they agree on what every member was checked against, so a
+// trusted receiver can rebuild members with assume_valid. An untrusted
+// receiver runs decode<S> on every record, with the same checks as
+// Valid<S>.
+//
+// Trust removes checks, not framing: the header, fingerprint and sizes are
+// always verified.
+
+#ifndef REFINERY_WIRE_HPP
+#define REFINERY_WIRE_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <meta>
+
+#include "decode.hpp"
+
+namespace refinery {
+
+// What a receiver checks in frames from a given peer
+enum class wire_trust {
+    validate, // check every member of every record
+    trusted,  // peer validated before sending; decode without checks
+};
+
+// Why decode_frame rejected its input
+struct wire_error {
+    enum class kind {
+        truncated,       // fewer bytes than the header announces
+        schema_mismatch, // different fingerprint or record size
+        invalid_record,  // a record failed decode<S>; see cause
+    };
+
+    kind reason;
+    std::size_t record; // index of the failing record in the frame
+    decode_error cause; // for invalid_record
+};
+
+inline constexpr std::size_t wire_header_size = 16;
+
+namespace detail {
+
+template <typename S, std::endian Order>
+consteval std::uint64_t wire_schema() {
+    std::uint64_t hash =
+        fnv1a(Order == std::endian::big ? "big-endian" : "little-endian");
+    for (std::meta::info m : fields_of<S>()) {
+        hash = fnv1a(std::meta::identifier_of(m), hash);
+        hash = fingerprint_of(std::meta::type_of(m), hash);
+        for (std::meta::info a : std::meta::annotations_of(m))
+            hash = fingerprint_of(a, hash);
+    }
+    return hash;
+}
+
+// Store value at p in byte order Order
+template <wire_scalar T, std::endian Order>
+void store_scalar(std::byte* p, T value) noexcept {
+    if constexpr (Order != std::endian::native && sizeof(T) > 1) {
+        using U = typename uint_of_size<sizeof(T)>::type;
+        value = std::bit_cast<T>(std::byteswap(std::bit_cast<U>(value)));
+    }
+    std::memcpy(p, &value, sizeof(T));
+}
+
+template <typename S, std::endian Order>
+void encode_record(const S& s, std::byte* out) noexcept {
+    std::size_t offset = 0;
+    template for (constexpr std::meta::info m : fields_of<S>()) {
+        using W = wire_value_t<field_type<m>>;
+        const W value = [&] {
+            if constexpr (is_refined<field_type<m>>)
+                return s.[:m:].get();
+            else
+                return s.[:m:];
+        }();
+        store_scalar<W, Order>(out + offset, value);
+        offset += sizeof(W);
+    }
+}
+
+struct wire_header {
+    std::uint64_t schema;
+    std::uint32_t count;
+    std::uint32_t record_size;
+};
+
+inline wire_header load_wire_header(const std::byte* p) noexcept {
+    return {load_scalar<std::uint64_t, std::endian::little>(p),
+            load_scalar<std::uint32_t, std::endian::little>(p + 8),
+            load_scalar<std::uint32_t, std::endian::little>(p + 12)};
+}
+
+} // namespace detail
+
+// Fingerprint of S's wire schema in byte order Order
+template <wire_record S, std::endian Order = std::endian::little>
+inline constexpr std::uint64_t wire_schema_v = detail::wire_schema<S, Order>();
+
+// Append one frame holding records to out. A frame holds at most 2^32 - 1
+// records, the most its header can count; a larger batch throws
+// refinement_error and leaves out as it was, so split it first.
+template <wire_record S, std::endian Order = std::endian::little>
+void encode_frame(std::span<const S> records, std::vector<std::byte>& out) {
+    constexpr std::size_t record_size = wire_size_v<S>;
+    if (records.size() > std::numeric_limits<std::uint32_t>::max())
+        throw refinement_error(
+            std::string("encode_frame batch exceeds 2^32 - 1 records"));
+    const std::size_t start = out.size();
+    out.resize(start + wire_header_size + records.size() * record_size);
+    std::byte* p = out.data() + start;
+    detail::store_scalar<std::uint64_t, std::endian::little>(
+        p, wire_schema_v<S, Order>);
+    detail::store_scalar<std::uint32_t, std::endian::little>(
+        p + 8, static_cast<std::uint32_t>(records.size()));
+    detail::store_scalar<std::uint32_t, std::endian::little>(
+        p + 12, static_cast<std::uint32_t>(record_size));
+    p += wire_header_size;
+    for (const S& s : records) {
+        detail::encode_record<S, Order>(s, p);
+        p += record_size;
+    }
+}
+
+// Total size of the frame starting at bytes, once its header has arrived;
+// for reading frames off a stream
+[[nodiscard]] inline std::optional<std::size_t>
+frame_size(std::span<const std::byte> bytes) noexcept {
+    if (bytes.size() < wire_header_size)
+        return std::nullopt;
+    const auto h = detail::load_wire_header(bytes.data());
+    return wire_header_size + std::size_t{h.count} * h.record_size;
+}
+
+// Decode the frame at the front of bytes, appending its records to out.
+// Returns the number of bytes consumed. On error out is left as it was.
+template <wire_record S, std::endian Order = std::endian::little>
+[[nodiscard]] std::expected<std::size_t, wire_error>
+decode_frame(std::span<const std::byte> bytes, wire_trust trust,
+             std::vector<S>& out) {
+    using enum wire_error::kind;
+    constexpr std::size_t record_size = wire_size_v<S>;
+    const auto total = frame_size(bytes);
+    if (!total || bytes.size() < *total)
+        return std::unexpected(wire_error{truncated, 0, {}});
+    const auto h = detail::load_wire_header(bytes.data());
+    if (h.schema != wire_schema_v<S, Order> || h.record_size != record_size)
+        return std::unexpected(wire_error{schema_mismatch, 0, {}});
+
+    const std::size_t before = out.size();
+    out.reserve(before + h.count);
+    const std::byte* p = bytes.data() + wire_header_size;
+    for (std::size_t i = 0; i < h.count; ++i, p += record_size) {
+        const std::span<const std::byte> record(p, record_size);
+        auto s = trust == wire_trust::trusted
+                     ? detail::decode_record<S, Order, false>(record)
+                     : detail::decode_record<S, Order, true>(record);
+        if (!s) {
+            out.erase(out.begin() + static_cast<std::ptrdiff_t>(before),
+                      out.end());
+            return std::unexpected(wire_error{invalid_record, i, s.error()});
+        }
+        out.push_back(*s);
+    }
+    return *total;
+}
+
+} // namespace refinery
+
+#endif // REFINERY_WIRE_HPP
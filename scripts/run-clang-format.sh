@@ -24,6 +24,7 @@ if [[ ${#FILES[@]} -eq 0 ]]; then
         find "$REPO_ROOT/include/refinery" \
              "$REPO_ROOT/tests" \
              "$REPO_ROOT/examples/zero_overhead" \
+             "$REPO_ROOT/benchmarks" \
             -type f \( -name '*.hpp' -o -name '*.cpp' \) \
             2>/dev/null | sort
     )
@@ -1,11 +1,43 @@
 // test_refine.cpp - Test suite for C++26 Refinement Types Library
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cmath>
+#include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
 #include <limits>
 #include <numbers>
+#include <refinery/algorithm.hpp>
+#include <refinery/aligned.hpp>
+#include <refinery/atomic.hpp>
+#include <refinery/bounded.hpp>
+#include <refinery/bulk.hpp>
+#include <refinery/bytes.hpp>
+#include <refinery/charconv.hpp>
+#include <refinery/columnar.hpp>
+#include <refinery/counter.hpp>
+#include <refinery/decode.hpp>
 #include <refinery/domain.hpp>
+#include <refinery/mmap.hpp>
+#include <refinery/packed.hpp>
 #include <refinery/refinery.hpp>
+#include <refinery/reflect.hpp>
+#include <refinery/regex.hpp>
+#include <refinery/ring.hpp>
+#include <refinery/snapshot.hpp>
+#include <refinery/soa.hpp>
+#include <refinery/sorted.hpp>
+#include <refinery/span.hpp>
+#include <refinery/stream.hpp>
+#include <refinery/tabulated.hpp>
+#include <refinery/text.hpp>
+#include <refinery/wire.hpp>
+#include <regex>
+#include <string>
+#include <thread>
+#include <unistd.h>
 
 using namespace refinery;
 
@@ -1078,3 +1110,2162 @@ TEST(Operations, FloatArithmeticUnchanged) {
     static_assert(std::same_as<decltype(neg), double>);
     EXPECT_DOUBLE_EQ(neg, -5.0);
 }
+
+// ---- Tabulated Predicate Tests ----
+
+namespace {
+
+constexpr auto IdentByte = Any<InRange('a', 'z'), InRange('A', 'Z'),
+                               InRange('0', '9'), EqualTo('_')>;
+
+template <auto Pred, typename T> consteval bool table_matches_predicate() {
+    constexpr auto tab = Tabulated<Pred, T>;
+    for (long i = std::numeric_limits<T>::min();
+         i <= std::numeric_limits<T>::max(); ++i) {
+        auto v = static_cast<T>(i);
+        if (tab(v) != static_cast<bool>(Pred(v)))
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(Tabulated, MatchesUnderlyingPredicate) {
+    static_assert(table_matches_predicate<IdentByte, char>());
+    static_assert(table_matches_predicate<All<Positive, Not<DivisibleBy(3)>>,
+                                          std::uint8_t>());
+    static_assert(table_matches_predicate<Any<Negative, Even>, std::int8_t>());
+    static_assert(table_matches_predicate<Xor<Even, InRange(-1000, 1000)>,
+                                          std::int16_t>());
+}
+
+TEST(Tabulated, RefinedConstruction) {
+    using IdentChar = Refined<char, Tabulated<IdentByte, char>>;
+    constexpr IdentChar c{'x'};
+    static_assert(c.get() == 'x');
+
+    IdentChar r{'_', runtime_check};
+    EXPECT_EQ(r.get(), '_');
+    EXPECT_THROW(IdentChar('-', runtime_check), refinement_error);
+    EXPECT_FALSE(try_refine<IdentChar>('\xff').has_value());
+
+    using Small = Refined<std::int16_t, Tabulated<Not<Zero>, std::int16_t>>;
+    EXPECT_TRUE(try_refine<Small>(std::int16_t{-32768}).has_value());
+    EXPECT_FALSE(try_refine<Small>(std::int16_t{0}).has_value());
+}
+
+TEST(Tabulated, ImpliesUnderlyingPredicate) {
+    using Tab = Refined<std::uint8_t, Tabulated<NonZero, std::uint8_t>>;
+    Tab t{std::uint8_t{7}, runtime_check};
+    Refined<std::uint8_t, NonZero> nz = t;
+    EXPECT_EQ(nz.get(), 7);
+
+    Tab back = nz;
+    EXPECT_EQ(back.get(), 7);
+}
+
+TEST(Tabulated, SpanAllOfAndFindInvalid) {
+    constexpr auto tab = Tabulated<IdentByte, char>;
+    std::string ok(100, 'a');
+    for (std::size_t i = 0; i < ok.size(); ++i)
+        ok[i] = "abcXYZ019_"[i % 10];
+    EXPECT_TRUE(tab.all_of(ok));
+    EXPECT_EQ(tab.find_invalid(ok), ok.size());
+
+    // Every position, covering the 32-byte, 16-byte and scalar paths
+    for (std::size_t pos = 0; pos < ok.size(); ++pos) {
+        std::string bad = ok;
+        bad[pos] = static_cast<char>(0x80 + pos % 64);
+        EXPECT_EQ(tab.find_invalid(bad), pos);
+        EXPECT_FALSE(tab.all_of(bad));
+    }
+
+    EXPECT_TRUE(tab.all_of(std::span<const char>{}));
+    static_assert(tab.find_invalid(std::string_view{"ab-c"}) == 2);
+}
+
+TEST(Tabulated, AllByteValues) {
+    constexpr auto tab =
+        Tabulated<All<Odd, Not<InRange(64, 127)>>, std::uint8_t>;
+    std::array<std::uint8_t, 256> bytes{};
+    for (std::size_t i = 0; i < bytes.size(); ++i)
+        bytes[i] = static_cast<std::uint8_t>(i);
+    std::size_t expected = 0;
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        if (!tab(bytes[i])) {
+            expected = i;
+            break;
+        }
+    }
+    EXPECT_EQ(tab.find_invalid(bytes), expected);
+
+    std::vector<std::uint8_t> odd_low;
+    for (int i = 1; i < 64; i += 2)
+        odd_low.push_back(static_cast<std::uint8_t>(i));
+    for (int i = 129; i < 256; i += 2)
+        odd_low.push_back(static_cast<std::uint8_t>(i));
+    EXPECT_TRUE(tab.all_of(odd_low));
+}
+
+TEST(Tabulated, AutomaticOptIn) {
+    using EvenU8 = TabulatedRefined<std::uint8_t, Even>;
+    using EvenI16 = TabulatedRefined<std::int16_t, Even>;
+    using EvenI32 = TabulatedRefined<std::int32_t, Even>;
+    using Digit = TabulatedRefined<std::uint8_t, Interval<0, 9>{}>;
+    static_assert(tabulated_predicate<EvenU8::predicate>);
+    static_assert(tabulated_predicate<EvenI16::predicate>);
+    static_assert(!tabulated_predicate<EvenI32::predicate>);
+    static_assert(interval_predicate<Digit::predicate>);
+
+    EvenU8 e{std::uint8_t{4}, runtime_check};
+    EXPECT_EQ(e.get(), 4);
+    EXPECT_THROW(EvenU8(std::uint8_t{3}, runtime_check), refinement_error);
+}
+
+// ---- Text Predicate Tests ----
+
+TEST(Text, CharacterClasses) {
+    static_assert(IsDigit('7') && !IsDigit('a'));
+    static_assert(IsAlpha('q') && IsAlpha('Q') && !IsAlpha('1'));
+    static_assert(IsAlnum('z') && IsAlnum('0') && !IsAlnum('_'));
+    static_assert(IsHexDigit('f') && IsHexDigit('A') && !IsHexDigit('g'));
+    static_assert(IsSpace(' ') && IsSpace('\t') && !IsSpace('x'));
+    static_assert(IsPrint('~') && !IsPrint('\x7f'));
+}
+
+TEST(Text, CompileTimeEvaluation) {
+    static_assert(Ascii(std::string_view{"hello"}));
+    static_assert(!Ascii(std::string_view{"h\xc3\xa9llo"}));
+    static_assert(NoNul(std::string_view{"abc"}));
+    static_assert(!NoNul(std::string_view{"a\0c", 3}));
+    static_assert(ValidUtf8(std::string_view{"h\xc3\xa9llo \xe2\x82\xac"}));
+    static_assert(!ValidUtf8(std::string_view{"\xc0\xaf"}));
+    static_assert(CharsIn<IsDigit>(std::string_view{"0123"}));
+    static_assert(!CharsIn<IsDigit>(std::string_view{"01a3"}));
+}
+
+TEST(Text, RefinedStrings) {
+    constexpr auto IdentChars = CharsIn<Any<IsAlnum, EqualTo('_')>>;
+    using Identifier = Refined<std::string, All<NonEmpty, IdentChars>>;
+    Identifier id{std::string("snake_case_42"), runtime_check};
+    EXPECT_EQ(id.get(), "snake_case_42");
+    EXPECT_THROW(Identifier(std::string("kebab-case"), runtime_check),
+                 refinement_error);
+    EXPECT_FALSE(try_refine<Identifier>(std::string()).has_value());
+
+    using HexToken = Refined<std::string_view, CharsIn<IsHexDigit>>;
+    EXPECT_TRUE(try_refine<HexToken>(std::string_view{"deadBEEF"}));
+    EXPECT_FALSE(try_refine<HexToken>(std::string_view{"0xdead"}));
+}
+
+TEST(Text, LongInputsEveryPosition) {
+    std::string base(200, 'a');
+    EXPECT_TRUE(Ascii(base));
+    EXPECT_TRUE(NoNul(base));
+    EXPECT_TRUE(ValidUtf8(base));
+    EXPECT_TRUE(CharsIn<IsLower>(base));
+
+    for (std::size_t pos = 0; pos < base.size(); ++pos) {
+        std::string high = base;
+        high[pos] = '\xe9';
+        EXPECT_FALSE(Ascii(high));
+        EXPECT_FALSE(ValidUtf8(high));
+        EXPECT_FALSE(CharsIn<IsLower>(high));
+
+        std::string nul = base;
+        nul[pos] = '\0';
+        EXPECT_FALSE(NoNul(nul));
+        EXPECT_TRUE(Ascii(nul));
+    }
+}
+
+TEST(Text, Utf8Sequences) {
+    // Valid: 1- to 4-byte sequences at every offset across block boundaries
+    const std::string_view seqs[] = {"\xc2\x80", "\xdf\xbf", "\xe0\xa0\x80",
+                                     "\xed\x9f\xbf", "\xef\xbf\xbf",
+                                     "\xf0\x90\x80\x80", "\xf4\x8f\xbf\xbf"};
+    for (std::string_view seq : seqs) {
+        for (std::size_t pad = 0; pad < 70; ++pad) {
+            std::string s(pad, 'x');
+            s += seq;
+            s += "tail";
+            EXPECT_TRUE(ValidUtf8(s));
+        }
+    }
+
+    // Invalid: overlongs, surrogates, out of range, stray/missing bytes
+    const std::string_view bad[] = {
+        "\xc0\x80",         "\xc1\xbf",         "\xe0\x80\x80",
+        "\xe0\x9f\xbf",     "\xed\xa0\x80",     "\xed\xbf\xbf",
+        "\xf0\x80\x80\x80", "\xf0\x8f\xbf\xbf", "\xf4\x90\x80\x80",
+        "\xf5\x80\x80\x80", "\xff",             "\x80",
+        "\xc2",             "\xe2\x82",         "\xf0\x9f\x98",
+        "\xc2\xc2\x80",     "\xe2\x82\xac\xac"};
+    for (std::string_view seq : bad) {
+        for (std::size_t pad = 0; pad < 70; ++pad) {
+            std::string s(pad, 'x');
+            s += seq;
+            EXPECT_FALSE(ValidUtf8(s));
+            s += "tail";
+            EXPECT_FALSE(ValidUtf8(s));
+        }
+    }
+}
+
+TEST(Text, Utf8MatchesScalarReference) {
+    // Random byte soup biased towards UTF-8 lead/continuation bytes
+    std::uint32_t state = 12345;
+    auto next = [&] {
+        state = state * 1664525u + 1013904223u;
+        return state >> 24;
+    };
+    const unsigned char alphabet[] = {'a',  0x80, 0x8f, 0x90, 0x9f, 0xa0,
+                                      0xbf, 0xc2, 0xdf, 0xe0, 0xe1, 0xed,
+                                      0xef, 0xf0, 0xf3, 0xf4, 0xf5, 0xc0};
+    for (int iter = 0; iter < 5000; ++iter) {
+        std::string s(next() % 100, '\0');
+        for (char& c : s)
+            c = static_cast<char>(alphabet[next() % sizeof(alphabet)]);
+        EXPECT_EQ(ValidUtf8(s), detail::utf8_scalar(s));
+    }
+}
+
+// ---- Regex Predicate Tests ----
+
+TEST(Regex, LiteralsAndClasses) {
+    static_assert(Matches<"abc">(std::string_view{"abc"}));
+    static_assert(!Matches<"abc">(std::string_view{"abcd"}));
+    static_assert(!Matches<"abc">(std::string_view{"ab"}));
+    static_assert(Matches<"[a-c]x[^0-9]">(std::string_view{"bx!"}));
+    static_assert(!Matches<"[a-c]x[^0-9]">(std::string_view{"bx7"}));
+    static_assert(Matches<"\\d\\w\\s\\.">(std::string_view{"7_ ."}));
+    static_assert(!Matches<"\\d\\w\\s\\.">(std::string_view{"7_ x"}));
+    static_assert(Matches<"[\\d_-]+">(std::string_view{"12-_3"}));
+    static_assert(Matches<"a.c">(std::string_view{"a-c"}));
+    static_assert(!Matches<"a.c">(std::string_view{"a\nc"}));
+    static_assert(Matches<"\\x41\\t">(std::string_view{"A\t"}));
+}
+
+// True if the pattern is rejected at compile time
+consteval bool regex_rejects(std::string_view pattern) {
+    try {
+        std::size_t root = 0;
+        detail::regex::parser(pattern).parse(root);
+        return false;
+    } catch (const std::meta::exception&) {
+        return true;
+    }
+}
+
+TEST(Regex, UnsupportedEscapesAreRejected) {
+    // Inside a class \b is a backspace, as in std::regex
+    static_assert(Matches<"a[\\b]c">(std::string_view{"a\bc"}));
+    static_assert(!Matches<"a[\\b]c">(std::string_view{"abc"}));
+    static_assert(Matches<"\\-\\[\\]">(std::string_view{"-[]"}));
+
+    // Assertions, back-references and Unicode escapes are not literals
+    static_assert(regex_rejects("\\bword\\b"));
+    static_assert(regex_rejects("\\B"));
+    static_assert(regex_rejects("(a)\\1"));
+    static_assert(regex_rejects("\\cA"));
+    static_assert(regex_rejects("\\u0041"));
+    static_assert(regex_rejects("\\p{L}"));
+    static_assert(regex_rejects("\\k<x>"));
+    static_assert(regex_rejects("[\\q]"));
+    static_assert(!regex_rejects("\\x41[\\b\\d]\\."));
+}
+
+TEST(Regex, QuantifiersAndAlternation) {
+    constexpr auto ticker = Matches<"^[A-Z]{1,5}(\\.[A-Z])?$">;
+    static_assert(ticker(std::string_view{"AAPL"}));
+    static_assert(ticker(std::string_view{"BRK.B"}));
+    static_assert(!ticker(std::string_view{"TOOLONG"}));
+    static_assert(!ticker(std::string_view{""}));
+    static_assert(!ticker(std::string_view{"aapl"}));
+
+    constexpr auto ab = Matches<"(?:ab|cd)*e+f?">;
+    static_assert(ab(std::string_view{"e"}));
+    static_assert(ab(std::string_view{"abcdabeeef"}));
+    static_assert(!ab(std::string_view{"abcf"}));
+    static_assert(!ab(std::string_view{"eff"}));
+
+    constexpr auto range = Matches<"x{2,}y{0,2}z{3}">;
+    static_assert(range(std::string_view{"xxzzz"}));
+    static_assert(range(std::string_view{"xxxxxyyzzz"}));
+    static_assert(!range(std::string_view{"xzzz"}));
+    static_assert(!range(std::string_view{"xxyyyzzz"}));
+
+    static_assert(Matches<"">(std::string_view{""}));
+    static_assert(Matches<"a|">(std::string_view{""}));
+    static_assert(Matches<"a+?">(std::string_view{"aaa"}));
+}
+
+TEST(Regex, MinimizedDfa) {
+    // (a|b)*abb has a 4-state minimal DFA, plus the dead state
+    constexpr auto abb = Matches<"(a|b)*abb">;
+    static_assert(abb.dfa.accepting.size() == 5);
+    EXPECT_TRUE(abb(std::string_view{"babaabb"}));
+    EXPECT_FALSE(abb(std::string_view{"babaab"}));
+
+    // Redundant alternatives collapse to the same automaton
+    static_assert(Matches<"a*">.dfa.accepting.size() ==
+                  Matches<"(a|a)*|a">.dfa.accepting.size());
+}
+
+TEST(Regex, RefinedStrings) {
+    using Ticker = Refined<std::string_view, Matches<"[A-Z]{1,5}">>;
+    constexpr Ticker t{"MSFT"};
+    static_assert(t.get() == "MSFT");
+
+    EXPECT_TRUE(try_refine<Ticker>(std::string_view{"GOOG"}).has_value());
+    EXPECT_FALSE(try_refine<Ticker>(std::string_view{"goog"}).has_value());
+    EXPECT_THROW(Ticker(std::string_view{"123"}, runtime_check),
+                 refinement_error);
+
+    using Uuid =
+        Refined<std::string, Matches<"[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-"
+                                     "[0-9a-f]{4}-[0-9a-f]{12}">>;
+    EXPECT_TRUE(
+        try_refine<Uuid>(std::string("123e4567-e89b-12d3-a456-426614174000")));
+    EXPECT_FALSE(
+        try_refine<Uuid>(std::string("123e4567-e89b-12d3-a456-42661417400")));
+}
+
+TEST(Regex, AgreesWithStdRegex) {
+    constexpr auto p1 = Matches<"(ab|a)*b?c{1,3}">;
+    constexpr auto p2 = Matches<"[^c]+(c|bb)a*">;
+    constexpr auto p3 = Matches<"a?b?c?(a|b)+">;
+    const std::regex r1("(ab|a)*b?c{1,3}");
+    const std::regex r2("[^c]+(c|bb)a*");
+    const std::regex r3("a?b?c?(a|b)+");
+
+    // Every string over {a, b, c} up to length 7
+    std::string s;
+    for (std::size_t len = 0; len <= 7; ++len) {
+        std::size_t total = 1;
+        for (std::size_t i = 0; i < len; ++i)
+            total *= 3;
+        for (std::size_t code = 0; code < total; ++code) {
+            s.clear();
+            for (std::size_t i = 0, c = code; i < len; ++i, c /= 3)
+                s.push_back(static_cast<char>('a' + c % 3));
+            EXPECT_EQ(p1(s), std::regex_match(s, r1));
+            EXPECT_EQ(p2(s), std::regex_match(s, r2));
+            EXPECT_EQ(p3(s), std::regex_match(s, r3));
+        }
+    }
+}
+
+// ---- Parse Tests ----
+
+TEST(ParseRefined, DomainAliases) {
+    static_assert(parse_refined<PortNumber<>>("443")->get() == 443);
+
+    auto port = parse_refined<PortNumber<>>("8080");
+    ASSERT_TRUE(port.has_value());
+    EXPECT_EQ(port->get(), 8080);
+    EXPECT_EQ(parse_refined<PortNumber<>>("0").error(),
+              parse_error::out_of_range);
+    EXPECT_EQ(parse_refined<PortNumber<>>("65536").error(),
+              parse_error::out_of_range);
+    EXPECT_EQ(parse_refined<PortNumber<>>("-1").error(),
+              parse_error::out_of_range);
+    EXPECT_EQ(parse_refined<PortNumber<>>("80a").error(),
+              parse_error::invalid_syntax);
+    EXPECT_EQ(parse_refined<PortNumber<>>("").error(),
+              parse_error::invalid_syntax);
+    EXPECT_EQ(parse_refined<PortNumber<>>("+80").error(),
+              parse_error::invalid_syntax);
+    EXPECT_EQ(parse_refined<PortNumber<>>("-").error(),
+              parse_error::invalid_syntax);
+
+    EXPECT_EQ(parse_refined<Percentage<>>("100")->get(), 100);
+    EXPECT_EQ(parse_refined<Percentage<>>("000042")->get(), 42);
+    EXPECT_EQ(parse_refined<Percentage<>>("101").error(),
+              parse_error::out_of_range);
+    EXPECT_EQ(parse_refined<Percentage<std::uint8_t>>("-5").error(),
+              parse_error::invalid_syntax);
+    EXPECT_EQ(parse_refined<ByteValue<std::uint8_t>>("255")->get(), 255);
+
+    EXPECT_DOUBLE_EQ(parse_refined<Probability<>>("0.25")->get(), 0.25);
+    EXPECT_EQ(parse_refined<Probability<>>("1.5").error(),
+              parse_error::out_of_range);
+    EXPECT_EQ(parse_refined<Probability<>>("0.5x").error(),
+              parse_error::invalid_syntax);
+}
+
+TEST(ParseRefined, EarlyRejection) {
+    // Far longer than any int64: rejected by the bound, not by overflow
+    EXPECT_EQ(
+        parse_refined<PortNumber<std::int64_t>>("999999999999999999999999999")
+            .error(),
+        parse_error::out_of_range);
+    // Bounds wider than T are clamped to T
+    EXPECT_EQ(parse_refined<PortNumber<std::int16_t>>("32767")->get(), 32767);
+    EXPECT_EQ(parse_refined<PortNumber<std::int16_t>>("32768").error(),
+              parse_error::out_of_range);
+
+    using Temperature = IntervalRefined<std::int32_t, -40, -10>;
+    EXPECT_EQ(parse_refined<Temperature>("-40")->get(), -40);
+    EXPECT_EQ(parse_refined<Temperature>("-41").error(),
+              parse_error::out_of_range);
+    EXPECT_EQ(parse_refined<Temperature>("-9").error(),
+              parse_error::out_of_range);
+    EXPECT_EQ(parse_refined<Temperature>("5").error(),
+              parse_error::out_of_range);
+
+    // Bounds entirely outside T admit nothing; they must not collapse onto
+    // T's max or min
+    using Above = Refined<std::int8_t, Interval<200, 300>{}>;
+    using Below = Refined<std::uint8_t, Interval<-9, -1>{}>;
+    EXPECT_FALSE(parse_refined<Above>("127").has_value());
+    EXPECT_FALSE(parse_refined<Above>("-128").has_value());
+    EXPECT_FALSE(parse_refined<Below>("0").has_value());
+    EXPECT_FALSE(parse_refined<Below>("255").has_value());
+    EXPECT_EQ(parse_column<Above>("127\n0\n").values.size(), 0u);
+}
+
+TEST(ParseRefined, MatchesTwoStepParse) {
+    using Small = IntervalRefined<std::int16_t, std::int16_t{-1000},
+                                  std::int16_t{5000}>;
+    const char* inputs[] = {"0",     "-0",    "5000",  "5001", "-1000",
+                            "-1001", "32767", "32768", "-999", "12x",
+                            "x12",   "",      "-",     "0005", "4999"};
+    for (std::string_view text : inputs) {
+        std::int16_t raw = 0;
+        auto [ptr, ec] =
+            std::from_chars(text.data(), text.data() + text.size(), raw);
+        bool two_step = ec == std::errc{} &&
+                        ptr == text.data() + text.size() &&
+                        Small::predicate(raw);
+        auto fused = parse_refined<Small>(text);
+        EXPECT_EQ(fused.has_value(), two_step);
+        if (fused)
+            EXPECT_EQ(fused->get(), raw);
+    }
+}
+
+TEST(ParseRefined, GeneralPredicates) {
+    EXPECT_EQ(parse_refined<NonZeroI32>("-17")->get(), -17);
+    EXPECT_EQ(parse_refined<NonZeroI32>("0").error(),
+              parse_error::predicate_failed);
+    EXPECT_EQ(parse_refined<NonZeroI32>("99999999999").error(),
+              parse_error::out_of_range);
+    EXPECT_DOUBLE_EQ(parse_refined<PositiveF64>("1e3")->get(), 1000.0);
+    EXPECT_EQ(parse_refined<PositiveF64>("-2.5").error(),
+              parse_error::predicate_failed);
+}
+
+// ---- Columnar Parse Tests ----
+
+TEST(Columnar, IntervalColumn) {
+    using Score = IntervalRefined<std::int32_t, -50, 100'000>;
+    auto col = parse_column<Score>("12\n-50\n100000\n100001\nabc\n\n7\r\n-51\n"
+                                   "0000000000000000000000042\n99999999999\n");
+    ASSERT_EQ(col.values.size(), 5u);
+    EXPECT_EQ(col.values[0].get(), 12);
+    EXPECT_EQ(col.values[1].get(), -50);
+    EXPECT_EQ(col.values[2].get(), 100000);
+    EXPECT_EQ(col.values[3].get(), 7);
+    EXPECT_EQ(col.values[4].get(), 42);
+    EXPECT_EQ(col.rejected, (std::vector<std::size_t>{3, 4, 5, 7, 9}));
+
+    // No trailing delimiter, custom delimiter
+    auto csv = parse_column<Refined<std::uint16_t, NonZero>>("1,0,65535,65536",
+                                                              ',');
+    ASSERT_EQ(csv.values.size(), 2u);
+    EXPECT_EQ(csv.values[1].get(), 65535);
+    EXPECT_EQ(csv.rejected, (std::vector<std::size_t>{1, 3}));
+}
+
+TEST(Columnar, DecimalColumn) {
+    auto col = parse_column<PositiveF64>(
+        "1.5\n0.1\n-2\n12345.678\n1e3\n.25\n7.\n-inf\n0\n");
+    ASSERT_EQ(col.values.size(), 6u);
+    EXPECT_EQ(col.values[0].get(), 1.5);
+    EXPECT_EQ(col.values[1].get(), 0.1);
+    EXPECT_EQ(col.values[2].get(), 12345.678);
+    EXPECT_EQ(col.values[3].get(), 1000.0);
+    EXPECT_EQ(col.values[4].get(), 0.25);
+    EXPECT_EQ(col.values[5].get(), 7.0);
+    EXPECT_EQ(col.rejected, (std::vector<std::size_t>{2, 7, 8}));
+
+    auto finite = parse_column<FiniteF32>("3.25\nnan\n-0.125\n");
+    ASSERT_EQ(finite.values.size(), 2u);
+    EXPECT_EQ(finite.values[1].get(), -0.125f);
+    EXPECT_EQ(finite.rejected, (std::vector<std::size_t>{1}));
+}
+
+TEST(Columnar, LongDoubleColumn) {
+    // 64 or more significand bits: the exactness bound must not shift by 64
+    const char* text = "1.5\n18446744073709551615\n0.000001\n-3.75\n";
+    auto col = parse_column<Refined<long double, Finite>>(text);
+    ASSERT_EQ(col.values.size(), 4u);
+    EXPECT_TRUE(col.rejected.empty());
+    EXPECT_EQ(col.values[0].get(), 1.5L);
+    EXPECT_EQ(col.values[1].get(), 18446744073709551615.0L);
+    EXPECT_EQ(col.values[2].get(), 0.000001L);
+    EXPECT_EQ(col.values[3].get(), -3.75L);
+}
+
+TEST(Columnar, MatchesFromChars) {
+    // Random fields of mixed shape, checked row by row against from_chars
+    std::uint64_t state = 42;
+    auto next = [&] {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return state >> 33;
+    };
+    const char alphabet[] = "0123456789-.0123456789e";
+    std::string text;
+    std::vector<std::string> fields;
+    for (int i = 0; i < 20000; ++i) {
+        std::string field;
+        std::size_t len = next() % 24;
+        for (std::size_t j = 0; j < len; ++j)
+            field.push_back(alphabet[next() % (sizeof(alphabet) - 1)]);
+        fields.push_back(field);
+        text += field;
+        text += '\n';
+    }
+
+    using I = IntervalRefined<std::int64_t, -123456789, 987654321012>;
+    auto ints = parse_column<I>(text);
+    auto doubles = parse_column<FiniteF64>(text);
+    std::size_t int_rows = 0;
+    std::size_t double_rows = 0;
+    std::size_t int_rejected = 0;
+    std::size_t double_rejected = 0;
+    for (std::size_t row = 0; row < fields.size(); ++row) {
+        const std::string& f = fields[row];
+        const char* end = f.data() + f.size();
+        std::int64_t iv = 0;
+        auto ir = std::from_chars(f.data(), end, iv);
+        if (ir.ec == std::errc{} && ir.ptr == end && I::predicate(iv)) {
+            ASSERT_LT(int_rows, ints.values.size());
+            EXPECT_EQ(ints.values[int_rows++].get(), iv);
+        } else {
+            ASSERT_LT(int_rejected, ints.rejected.size());
+            EXPECT_EQ(ints.rejected[int_rejected++], row);
+        }
+        double dv = 0;
+        auto dr = std::from_chars(f.data(), end, dv);
+        if (dr.ec == std::errc{} && dr.ptr == end && std::isfinite(dv)) {
+            ASSERT_LT(double_rows, doubles.values.size());
+            EXPECT_EQ(doubles.values[double_rows++].get(), dv);
+        } else {
+            ASSERT_LT(double_rejected, doubles.rejected.size());
+            EXPECT_EQ(doubles.rejected[double_rejected++], row);
+        }
+    }
+    EXPECT_EQ(int_rows, ints.values.size());
+    EXPECT_EQ(double_rows, doubles.values.size());
+}
+
+// ---- Bounded Formatting Tests ----
+
+TEST(BoundedFormat, ToChars) {
+    using Millis = IntervalRefined<std::int32_t, 0, 999>;
+    static_assert(max_chars_v<Millis> == 3);
+    static_assert(max_chars_v<PortNumber<>> == 5);
+    static_assert(max_chars_v<IntervalRefined<std::int8_t, -128, 127>> == 4);
+    static_assert(max_chars_v<PortNumber<std::int16_t>> == 5);
+
+    char buf[8];
+    auto check = [&](const auto& refined, std::string_view expected) {
+        auto [ptr, ec] = to_chars(buf, buf + sizeof(buf), refined);
+        EXPECT_TRUE(ec == std::errc{});
+        EXPECT_EQ(std::string_view(buf, ptr), expected);
+    };
+    check(Millis{0}, "0");
+    check(Millis{7}, "7");
+    check(Millis{42}, "42");
+    check(Millis{999}, "999");
+    check(PortNumber<>{65535}, "65535");
+    check(IntervalRefined<std::int8_t, -128, 127>{std::int8_t{-128}}, "-128");
+    check(IntervalRefined<std::int64_t, -20, -10>{std::int64_t{-15}}, "-15");
+    check(NonZeroI32{-12345}, "-12345");
+
+    // Not enough room
+    auto [ptr, ec] = to_chars(buf, buf + 2, Millis{123});
+    EXPECT_TRUE(ec == std::errc::value_too_large);
+    EXPECT_EQ(ptr, buf + 2);
+    auto [ptr2, ec2] = to_chars(buf, buf + 2, Millis{12});
+    EXPECT_TRUE(ec2 == std::errc{});
+    EXPECT_EQ(ptr2, buf + 2);
+}
+
+TEST(BoundedFormat, MatchesStdToChars) {
+    using Wide = IntervalRefined<std::int64_t,
+                                 std::numeric_limits<std::int64_t>::min(),
+                                 std::numeric_limits<std::int64_t>::max()>;
+    using Unsigned = IntervalRefined<std::uint64_t, std::uint64_t{0},
+                                     std::numeric_limits<std::uint64_t>::max()>;
+    char ours[32];
+    char theirs[32];
+    std::uint64_t x = 1;
+    for (int i = 0; i < 100000; ++i) {
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+        // Vary the magnitude so every digit count is covered
+        std::uint64_t u = x >> (x % 64);
+        auto s = static_cast<std::int64_t>(u) * ((x & 1) ? -1 : 1);
+        auto a = to_chars(ours, ours + 32, Wide{s, assume_valid});
+        auto b = std::to_chars(theirs, theirs + 32, s);
+        EXPECT_EQ(std::string_view(ours, a.ptr),
+                  std::string_view(theirs, b.ptr));
+        auto c = to_chars(ours, ours + 32, Unsigned{u, assume_valid});
+        auto d = std::to_chars(theirs, theirs + 32, u);
+        EXPECT_EQ(std::string_view(ours, c.ptr),
+                  std::string_view(theirs, d.ptr));
+    }
+}
+
+TEST(BoundedFormat, OutOfContractValuesFallBack) {
+    // A value outside the interval (from assume_valid or a trusted load)
+    // must not be written into a buffer sized for the interval
+    using Millis = IntervalRefined<std::int32_t, 0, 999>;
+    using Small = IntervalRefined<std::uint8_t, std::uint8_t{0},
+                                  std::uint8_t{9}>;
+    const Millis big{2000000000, assume_valid};
+    const Millis negative{-123456, assume_valid};
+    const Small wide{std::uint8_t{255}, assume_valid};
+
+    char buf[16];
+    auto [ptr, ec] = to_chars(buf, buf + sizeof(buf), big);
+    EXPECT_TRUE(ec == std::errc{});
+    EXPECT_EQ(std::string_view(buf, ptr), "2000000000");
+    auto [ptr2, ec2] = to_chars(buf, buf + sizeof(buf), negative);
+    EXPECT_TRUE(ec2 == std::errc{});
+    EXPECT_EQ(std::string_view(buf, ptr2), "-123456");
+    auto [ptr3, ec3] = to_chars(buf, buf + 3, big);
+    EXPECT_TRUE(ec3 == std::errc::value_too_large);
+
+    EXPECT_EQ(std::format("{}", big), "2000000000");
+    EXPECT_EQ(std::format("{}", negative), "-123456");
+    EXPECT_EQ(std::format("{}", wide), "255");
+}
+
+TEST(BoundedFormat, StdFormat) {
+    using Millis = IntervalRefined<std::int32_t, 0, 999>;
+    using Offset = IntervalRefined<std::int32_t, -50, 50>;
+    EXPECT_EQ(std::format("{}", Millis{42}), "42");
+    EXPECT_EQ(std::format("{} {}", Offset{-7}, Offset{50}), "-7 50");
+    // Non-empty specs go through std::formatter<T>
+    EXPECT_EQ(std::format("[{:>4}]", Millis{42}), "[  42]");
+    EXPECT_EQ(std::format("{:x}", Millis{255}), "ff");
+}
+
+// ---- Reflection Validation Tests ----
+
+struct Order {
+    [[= check<Positive>]] std::int32_t quantity;
+    [[= check<Finite>, = check<NonNegative>]] double price;
+    PortNumber<> port;
+    int note; // not checked
+};
+
+struct Unchecked {
+    int a;
+    double b;
+};
+
+TEST(ReflectValidation, FieldChecks) {
+    static_assert(validatable<Order>);
+    static_assert(!validatable<Unchecked>);
+
+    static_assert(Valid<Order>(Order{3, 9.5, PortNumber<>{80}, -1}));
+    static_assert(!Valid<Order>(Order{0, 9.5, PortNumber<>{80}, 0}));
+    static_assert(!Valid<Order>(Order{3, -1.0, PortNumber<>{80}, 0}));
+
+    // Refined members are re-checked
+    Order raw{3, 9.5, PortNumber<>{0, assume_valid}, 0};
+    EXPECT_FALSE(Valid<Order>(raw));
+
+    Order bad{-2, std::numeric_limits<double>::infinity(), PortNumber<>{80},
+              0};
+    EXPECT_EQ(invalid_fields(bad),
+              (std::vector<std::string_view>{"quantity", "price"}));
+    EXPECT_TRUE(invalid_fields(Order{1, 1.0, PortNumber<>{1}, 0}).empty());
+}
+
+TEST(ReflectValidation, MatchesHandWrittenComposition) {
+    constexpr auto by_hand =
+        All<OnMember<&Order::quantity, Positive>,
+            OnMember<&Order::price, All<Finite, NonNegative>>,
+            OnMember<&Order::port,
+                     [](const PortNumber<>& p) { return IsPort(p.get()); }>>;
+    const std::int32_t quantities[] = {-1, 0, 1, 500};
+    const double prices[] = {-0.5, 0.0, 2.5,
+                             std::numeric_limits<double>::quiet_NaN()};
+    const std::int32_t ports[] = {0, 1, 65535, 70000};
+    for (auto q : quantities) {
+        for (auto p : prices) {
+            for (auto port : ports) {
+                Order o{q, p, PortNumber<>{port, assume_valid}, 0};
+                EXPECT_EQ(Valid<Order>(o), by_hand(o));
+            }
+        }
+    }
+}
+
+TEST(ReflectValidation, ValidatedToken) {
+    constexpr Validated<Order> order{Order{2, 1.25, PortNumber<>{443}, 0}};
+    static_assert(order.get().quantity == 2);
+
+    EXPECT_TRUE(try_refine<Validated<Order>>(
+                    Order{1, 0.0, PortNumber<>{8080}, 0})
+                    .has_value());
+    EXPECT_FALSE(try_refine<Validated<Order>>(
+                     Order{1, -3.0, PortNumber<>{8080}, 0})
+                     .has_value());
+    EXPECT_THROW(Validated<Order>(Order{0, 1.0, PortNumber<>{80}, 0},
+                                  runtime_check),
+                 refinement_error);
+}
+
+// ---- Decode Tests ----
+
+enum class Side : std::uint8_t { buy, sell };
+
+struct Fill {
+    IntervalRefined<std::uint8_t, 1, 4> version;
+    PortNumber<std::uint16_t> port;
+    [[= check<Positive>]] std::int32_t quantity;
+    PositiveF64 price;
+    Side side;
+    bool last;
+};
+
+template <typename T>
+void put(std::vector<std::byte>& out, T value, std::endian order) {
+    auto bytes = std::bit_cast<std::array<std::byte, sizeof(T)>>(value);
+    if (order != std::endian::native)
+        std::reverse(bytes.begin(), bytes.end());
+    out.insert(out.end(), bytes.begin(), bytes.end());
+}
+
+std::vector<std::byte> encode_fill(std::uint8_t version, std::uint16_t port,
+                                   std::int32_t quantity, double price,
+                                   std::uint8_t side, std::uint8_t last,
+                                   std::endian order) {
+    std::vector<std::byte> out;
+    put(out, version, order);
+    put(out, port, order);
+    put(out, quantity, order);
+    put(out, price, order);
+    put(out, side, order);
+    put(out, last, order);
+    return out;
+}
+
+TEST(Decode, BothByteOrders) {
+    static_assert(wire_record<Fill>);
+    static_assert(wire_size_v<Fill> == 17);
+
+    for (auto order : {std::endian::little, std::endian::big}) {
+        auto bytes = encode_fill(2, 8080, 150, 99.5, 1, 1, order);
+        auto fill = order == std::endian::little
+                        ? decode<Fill>(bytes)
+                        : decode<Fill, std::endian::big>(bytes);
+        ASSERT_TRUE(fill.has_value());
+        EXPECT_EQ(fill->version.get(), 2);
+        EXPECT_EQ(fill->port.get(), 8080);
+        EXPECT_EQ(fill->quantity, 150);
+        EXPECT_EQ(fill->price.get(), 99.5);
+        EXPECT_EQ(fill->side, Side::sell);
+        EXPECT_TRUE(fill->last);
+    }
+}
+
+TEST(Decode, ReportsFirstFailingField) {
+    constexpr auto le = std::endian::little;
+    auto expect_error = [](const std::vector<std::byte>& bytes,
+                           decode_error::kind reason, std::string_view field,
+                           std::size_t offset) {
+        auto fill = decode<Fill>(bytes);
+        ASSERT_FALSE(fill.has_value());
+        EXPECT_EQ(fill.error().reason, reason);
+        EXPECT_EQ(fill.error().field, field);
+        EXPECT_EQ(fill.error().offset, offset);
+    };
+    using enum decode_error::kind;
+    expect_error(encode_fill(5, 0, 0, -1.0, 0, 0, le), predicate_failed,
+                 "version", 0);
+    expect_error(encode_fill(1, 0, 1, 1.0, 0, 0, le), predicate_failed, "port",
+                 1);
+    expect_error(encode_fill(1, 80, 0, 1.0, 0, 0, le), predicate_failed,
+                 "quantity", 3);
+    expect_error(encode_fill(1, 80, 1, 0.0, 0, 0, le), predicate_failed,
+                 "price", 7);
+    expect_error(encode_fill(1, 80, 1, 1.0, 0, 2, le), invalid_representation,
+                 "last", 16);
+
+    auto bytes = encode_fill(1, 80, 1, 1.0, 0, 0, le);
+    bytes.pop_back();
+    expect_error(bytes, truncated, "", 16);
+}
+
+TEST(Decode, MatchesDecodeThenValidate) {
+    const std::int32_t quantities[] = {-1, 0, 7};
+    const double prices[] = {-2.0, 0.0, 3.25,
+                             std::numeric_limits<double>::quiet_NaN()};
+    const std::uint16_t ports[] = {0, 1, 65535};
+    for (auto q : quantities) {
+        for (auto p : prices) {
+            for (auto port : ports) {
+                auto fill = decode<Fill>(
+                    encode_fill(3, port, q, p, 0, 0, std::endian::little));
+                Fill raw{decltype(Fill::version){3},
+                         decltype(Fill::port)(port, assume_valid), q,
+                         PositiveF64(p, assume_valid), Side::buy, false};
+                EXPECT_EQ(fill.has_value(), Valid<Fill>(raw));
+            }
+        }
+    }
+}
+
+// ---- Struct-of-Arrays Tests ----
+
+struct Trade {
+    IntervalRefined<std::int32_t, 1000, 1200> venue;
+    PositiveI32 quantity;
+    [[= check<NonNegative>]] double fee;
+    std::int64_t timestamp;
+};
+
+TEST(StructOfArrays, RowsRoundTrip) {
+    RefinedSoA<Trade> trades;
+    static_assert(
+        std::same_as<RefinedSoA<Trade>::storage_type<&Trade::venue>,
+                     std::uint8_t>);
+    static_assert(
+        std::same_as<RefinedSoA<Trade>::storage_type<&Trade::quantity>,
+                     std::int32_t>);
+
+    trades.push_back(Trade{decltype(Trade::venue){1000}, PositiveI32{5}, 0.5,
+                           10});
+    trades.push_back(Trade{decltype(Trade::venue){1200}, PositiveI32{7}, 1.0,
+                           20});
+    ASSERT_EQ(trades.size(), 2u);
+    EXPECT_EQ(trades.storage<&Trade::venue>()[1], 200);
+    EXPECT_EQ(trades.get<&Trade::venue>(1).get(), 1200);
+    EXPECT_EQ(trades[0].get<&Trade::quantity>().get(), 5);
+    EXPECT_EQ(trades.record(1).timestamp, 20);
+
+    trades.set<&Trade::venue>(0, decltype(Trade::venue){1111});
+    EXPECT_EQ(trades[0].record().venue.get(), 1111);
+
+    std::vector<std::int32_t> venues;
+    for (auto v : trades.column<&Trade::venue>())
+        venues.push_back(v.get());
+    EXPECT_EQ(venues, (std::vector<std::int32_t>{1111, 1200}));
+}
+
+TEST(StructOfArrays, AppendValidatesColumns) {
+    RefinedSoA<Trade> trades;
+    const std::vector<std::int32_t> venues = {1000, 1100, 1150, 1200};
+    const std::vector<std::int32_t> quantities = {1, 2, 3, 4};
+    const std::vector<double> fees = {0.0, 1.0, 2.0, 3.0};
+    const std::vector<std::int64_t> stamps = {1, 2, 3, 4};
+    EXPECT_FALSE(trades.append(venues, quantities, fees, stamps).has_value());
+    EXPECT_EQ(trades.size(), 4u);
+
+    // The earliest failing row across all columns is reported
+    const std::vector<std::int32_t> bad_venues = {1000, 1000, 1000, 999};
+    const std::vector<double> bad_fees = {0.0, 0.0, -1.0, 0.0};
+    EXPECT_EQ(trades.append(bad_venues, quantities, bad_fees, stamps), 2u);
+    EXPECT_EQ(trades.append(bad_venues, quantities, fees, stamps), 3u);
+    EXPECT_EQ(trades.size(), 4u);
+
+    // Failures past the first 64-value block are located too
+    std::vector<std::int32_t> many(200, 1100), q(200, 1);
+    std::vector<double> f(200, 0.0);
+    std::vector<std::int64_t> t(200, 0);
+    q[150] = 0;
+    EXPECT_EQ(trades.append(many, q, f, t), 150u);
+}
+
+TEST(StructOfArrays, AppendRejectsRaggedColumns) {
+    RefinedSoA<Trade> trades;
+    const std::vector<std::int32_t> venues = {1000, 1100, 1150};
+    const std::vector<std::int32_t> quantities = {1, 2};
+    const std::vector<double> fees = {0.0, 1.0, 2.0, 3.0};
+    const std::vector<std::int64_t> stamps = {1, 2, 3};
+
+    // The first row missing from some column is reported, and every
+    // column is left as it was
+    EXPECT_EQ(trades.append(venues, quantities, fees, stamps), 2u);
+    EXPECT_EQ(trades.size(), 0u);
+    EXPECT_TRUE(trades.storage<&Trade::fee>().empty());
+
+    // An invalid row before the short column ends is reported first
+    const std::vector<double> bad_fees = {-1.0, 0.0, 0.0};
+    EXPECT_EQ(trades.append(venues, quantities, bad_fees, stamps), 0u);
+    EXPECT_EQ(trades.size(), 0u);
+}
+
+TEST(StructOfArrays, ScansMatchArrayOfStructs) {
+    std::vector<Trade> aos;
+    RefinedSoA<Trade> soa;
+    std::uint32_t state = 7;
+    for (int i = 0; i < 1000; ++i) {
+        state = state * 1664525u + 1013904223u;
+        Trade t{decltype(Trade::venue)(
+                    static_cast<std::int32_t>(1000 + (state >> 8) % 201),
+                    assume_valid),
+                PositiveI32(static_cast<std::int32_t>(1 + (state >> 16) % 50),
+                            assume_valid),
+                0.0, i};
+        aos.push_back(t);
+        soa.push_back(t);
+    }
+
+    auto late = [](std::int32_t v) { return v >= 1150; };
+    std::vector<std::size_t> expected;
+    std::size_t singles = 0;
+    for (std::size_t i = 0; i < aos.size(); ++i) {
+        if (late(aos[i].venue.get()))
+            expected.push_back(i);
+        singles += aos[i].quantity.get() == 1 ? 1 : 0;
+    }
+    EXPECT_EQ(soa.filter<&Trade::venue>(late), expected);
+    EXPECT_EQ(soa.count_if<&Trade::quantity>(
+                  [](std::int32_t q) { return q == 1; }),
+              singles);
+}
+
+// ---- Packed Record Tests ----
+
+struct IndexEntry {
+    IntervalRefined<int, 0, 100> score;
+    IntervalRefined<int, 0, 7> level;
+    Refined<bool, Always> active;
+    PortNumber<> port;
+};
+
+struct WideEntry {
+    IntervalRefined<std::int64_t, -1, std::int64_t{1} << 40> a;
+    IntervalRefined<std::uint32_t, 0u, 0xFFFF'FFFFu> b;
+    IntervalRefined<int, 5, 5> constant;
+    bool flag;
+};
+
+TEST(PackedRecord, FitsOneWord) {
+    using P = Packed<IndexEntry>;
+    static_assert(P::bits_used == 7 + 3 + 1 + 16);
+    static_assert(std::same_as<P::word_type, std::uint32_t>);
+    static_assert(sizeof(P) == 4 && sizeof(IndexEntry) == 16);
+
+    constexpr P packed(IndexEntry{IntervalRefined<int, 0, 100>{100},
+                                  IntervalRefined<int, 0, 7>{3},
+                                  Refined<bool, Always>{true},
+                                  PortNumber<>{65535}});
+    static_assert(packed.get<&IndexEntry::score>().get() == 100);
+    static_assert(packed.get<&IndexEntry::level>().get() == 3);
+    static_assert(packed.get<&IndexEntry::active>().get());
+    static_assert(packed.get<&IndexEntry::port>().get() == 65535);
+
+    P p = packed;
+    p.set<&IndexEntry::level>(IntervalRefined<int, 0, 7>{7});
+    p.set<&IndexEntry::port>(PortNumber<>{1});
+    EXPECT_EQ(p.get<&IndexEntry::level>().get(), 7);
+    EXPECT_EQ(p.get<&IndexEntry::port>().get(), 1);
+    EXPECT_EQ(p.get<&IndexEntry::score>().get(), 100);
+    EXPECT_TRUE(p.get<&IndexEntry::active>().get());
+    EXPECT_NE(p, packed);
+
+    IndexEntry back = p.unpack();
+    EXPECT_EQ(back.port.get(), 1);
+    EXPECT_EQ(P(back), p);
+}
+
+TEST(PackedRecord, OutOfContractFieldStaysInItsSlot) {
+    using P = Packed<IndexEntry>;
+    P p(IndexEntry{IntervalRefined<int, 0, 100>{0},
+                   IntervalRefined<int, 0, 7>{0}, Refined<bool, Always>{false},
+                   PortNumber<>{80}});
+
+    // 7-bit score and 3-bit level given values wider than their slots
+    p.set<&IndexEntry::score>(IntervalRefined<int, 0, 100>{-1, assume_valid});
+    p.set<&IndexEntry::level>(IntervalRefined<int, 0, 7>{1000, assume_valid});
+    EXPECT_FALSE(p.get<&IndexEntry::active>().get());
+    EXPECT_EQ(p.get<&IndexEntry::port>().get(), 80);
+}
+
+TEST(PackedRecord, SpillsToSecondWord) {
+    using P = Packed<WideEntry>;
+    static_assert(P::word_count == 2);
+    static_assert(std::same_as<P::word_type, std::uint64_t>);
+
+    const std::int64_t as[] = {-1, 0, std::int64_t{1} << 40};
+    const std::uint32_t bs[] = {0, 12345, 0xFFFF'FFFFu};
+    for (auto a : as) {
+        for (auto b : bs) {
+            P p(WideEntry{decltype(WideEntry::a)(a, assume_valid),
+                          decltype(WideEntry::b)(b, assume_valid),
+                          decltype(WideEntry::constant){5}, true});
+            WideEntry w = p.unpack();
+            EXPECT_EQ(w.a.get(), a);
+            EXPECT_EQ(w.b.get(), b);
+            EXPECT_EQ(w.constant.get(), 5);
+            EXPECT_TRUE(w.flag);
+        }
+    }
+}
+
+// ---- Atomic Refined Tests ----
+
+TEST(AtomicRefined, UpdatesPreservePredicate) {
+    using Level = IntervalRefined<int, 0, 10>;
+    AtomicRefined<int, Level::predicate> level{Level{9}};
+    static_assert(decltype(level)::is_always_lock_free);
+
+    EXPECT_EQ(level.fetch_add(1)->get(), 9);
+    EXPECT_FALSE(level.fetch_add(1).has_value());
+    EXPECT_EQ(level.load().get(), 10);
+    EXPECT_FALSE(level.fetch_sub(11).has_value());
+    EXPECT_EQ(level.fetch_sub(10)->get(), 10);
+
+    EXPECT_EQ(level.update([](int v) { return v + 4; })->get(), 4);
+    EXPECT_FALSE(level.update([](int v) { return v * 3; }).has_value());
+    EXPECT_FALSE(level
+                     .fetch_update([](int) -> std::optional<int> {
+                         return std::nullopt;
+                     })
+                     .has_value());
+    EXPECT_EQ(level.exchange(Level{7}).get(), 4);
+
+    Level expected{3};
+    EXPECT_FALSE(level.compare_exchange_strong(expected, Level{5}));
+    EXPECT_EQ(expected.get(), 7);
+    EXPECT_TRUE(level.compare_exchange_strong(expected, Level{5}));
+    EXPECT_EQ(level.load().get(), 5);
+}
+
+TEST(AtomicRefined, OverflowFails) {
+    AtomicRefined<std::int32_t, PositiveI32::predicate> big{
+        PositiveI32{std::numeric_limits<std::int32_t>::max()}};
+    EXPECT_FALSE(big.fetch_add(1).has_value());
+    EXPECT_EQ(big.load().get(), std::numeric_limits<std::int32_t>::max());
+}
+
+TEST(AtomicRefined, ContendedAcquireNeverExceedsBound) {
+    using Slots = IntervalRefined<int, 0, 100>;
+    AtomicRefined<int, Slots::predicate> slots{Slots{0}};
+    std::atomic<int> admitted{0};
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&] {
+                for (int i = 0; i < 1000; ++i) {
+                    if (slots.fetch_add(1))
+                        admitted.fetch_add(1);
+                }
+            });
+        }
+    }
+    EXPECT_EQ(admitted.load(), 100);
+    EXPECT_EQ(slots.load().get(), 100);
+}
+
+// ---- Bounded Counter Tests ----
+
+TEST(BoundedCounter, NeverLeavesInterval) {
+    BoundedCounter<4> permits;
+    static_assert(std::same_as<decltype(permits)::count_type,
+                               IntervalRefined<std::size_t, std::size_t{0},
+                                               std::size_t{4}>>);
+    EXPECT_EQ(permits.try_acquire(3)->get(), 1u);
+    EXPECT_FALSE(permits.try_acquire(2).has_value());
+    EXPECT_EQ(permits.in_use().get(), 3u);
+    EXPECT_TRUE(permits.release(3));
+    EXPECT_FALSE(permits.release(1));
+    EXPECT_EQ(permits.available().get(), 4u);
+}
+
+TEST(BoundedCounter, ShardedOverReleaseIsRefused) {
+    BoundedCounter<8, 4> permits; // two permits per shard
+    ASSERT_TRUE(permits.try_acquire(2).has_value());
+    ASSERT_TRUE(permits.try_acquire(2).has_value());
+    EXPECT_EQ(permits.in_use().get(), 4u);
+
+    // Returned permits spill past a full home shard into the others
+    EXPECT_TRUE(permits.release(3));
+    EXPECT_TRUE(permits.release(1));
+    EXPECT_EQ(permits.available().get(), 8u);
+
+    // Nothing is out, so any further release is refused, from any thread
+    EXPECT_FALSE(permits.release(1));
+    EXPECT_FALSE(permits.release(9));
+    std::jthread([&] { EXPECT_FALSE(permits.release(1)); }).join();
+    EXPECT_EQ(permits.available().get(), 8u);
+    EXPECT_EQ(permits.in_use().get(), 0u);
+}
+
+TEST(BoundedCounter, ShardedContention) {
+    BoundedCounter<64, 4> permits;
+    std::atomic<std::size_t> peak{0};
+    std::atomic<std::size_t> held{0};
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < 8; ++t) {
+            threads.emplace_back([&] {
+                for (int i = 0; i < 2000; ++i) {
+                    if (!permits.try_acquire())
+                        continue;
+                    std::size_t now = held.fetch_add(1) + 1;
+                    std::size_t seen = peak.load();
+                    while (now > seen && !peak.compare_exchange_weak(seen, now))
+                        ;
+                    held.fetch_sub(1);
+                    permits.release();
+                }
+            });
+        }
+    }
+    EXPECT_LE(peak.load(), 64u);
+    EXPECT_EQ(permits.in_use().get(), 0u);
+    EXPECT_EQ(permits.available().get(), 64u);
+}
+
+TEST(BoundedCounter, ShardedReleasesAreNeverLost) {
+    // More threads than permits, so acquires keep draining shards and
+    // releases keep finding their home shard full
+    BoundedCounter<8, 4> permits;
+    std::atomic<int> refused{0};
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < 16; ++t) {
+            threads.emplace_back([&] {
+                for (int i = 0; i < 20000; ++i) {
+                    if (!permits.try_acquire())
+                        continue;
+                    if (!permits.release())
+                        refused.fetch_add(1);
+                }
+            });
+        }
+    }
+    EXPECT_EQ(refused.load(), 0);
+    EXPECT_EQ(permits.in_use().get(), 0u);
+    EXPECT_EQ(permits.available().get(), 8u);
+}
+
+// ---- Ring Buffer Tests ----
+
+TEST(RingBuffer, SpscOrderAndBatches) {
+    SpscRing<PortNumber<>> ring(RingCapacity{4});
+    EXPECT_EQ(ring.capacity(), 4u);
+    EXPECT_FALSE(ring.try_pop().has_value());
+
+    const PortNumber<> ports[] = {PortNumber<>{1}, PortNumber<>{2},
+                                  PortNumber<>{3}, PortNumber<>{4},
+                                  PortNumber<>{5}};
+    EXPECT_EQ(ring.push(ports), 4u);
+    EXPECT_FALSE(ring.try_push(ports[4]));
+    EXPECT_EQ(ring.try_pop()->get(), 1);
+    EXPECT_TRUE(ring.try_push(ports[4]));
+
+    std::vector<PortNumber<>> out;
+    EXPECT_EQ(ring.pop(std::back_inserter(out), 10), 4u);
+    ASSERT_EQ(out.size(), 4u);
+    EXPECT_EQ(out.front().get(), 2);
+    EXPECT_EQ(out.back().get(), 5);
+    EXPECT_EQ(ring.size(), 0u);
+}
+
+TEST(RingBuffer, SpscAcrossThreads) {
+    using Value = IntervalRefined<int, 0, 1'000'000>;
+    SpscRing<Value> ring(RingCapacity{64});
+    constexpr int count = 100'000;
+    long long sum = 0;
+    std::jthread consumer([&] {
+        for (int received = 0; received < count;) {
+            if (auto v = ring.try_pop()) {
+                sum += v->get();
+                ++received;
+            }
+        }
+    });
+    for (int i = 0; i < count;) {
+        if (ring.try_push(Value(i, assume_valid)))
+            ++i;
+    }
+    consumer.join();
+    EXPECT_EQ(sum, static_cast<long long>(count) * (count - 1) / 2);
+}
+
+TEST(RingBuffer, MpmcDeliversEveryValueOnce) {
+    using Value = IntervalRefined<int, 0, 1'000'000>;
+    MpmcRing<Value> ring(RingCapacity{128});
+    constexpr int per_producer = 20'000;
+    std::atomic<long long> sum{0};
+    std::atomic<int> received{0};
+    {
+        std::vector<std::jthread> threads;
+        for (int p = 0; p < 2; ++p) {
+            threads.emplace_back([&, p] {
+                for (int i = 0; i < per_producer;) {
+                    Value v(p * per_producer + i, assume_valid);
+                    if (ring.try_push(v))
+                        ++i;
+                }
+            });
+        }
+        for (int c = 0; c < 2; ++c) {
+            threads.emplace_back([&] {
+                while (received.load() < 2 * per_producer) {
+                    if (auto v = ring.try_pop()) {
+                        sum += v->get();
+                        ++received;
+                    }
+                }
+            });
+        }
+    }
+    constexpr long long n = 2 * per_producer;
+    EXPECT_EQ(sum.load(), n * (n - 1) / 2);
+}
+
+TEST(RingBuffer, MpmcNeedsTwoSlots) {
+    EXPECT_THROW(MpmcRing<PortNumber<>>(RingCapacity{1}), refinement_error);
+
+    MpmcRing<PortNumber<>> ring(RingCapacity{2});
+    EXPECT_TRUE(ring.try_push(PortNumber<>{1}));
+    EXPECT_TRUE(ring.try_push(PortNumber<>{2}));
+    EXPECT_FALSE(ring.try_push(PortNumber<>{3}));
+    EXPECT_EQ(ring.try_pop()->get(), 1);
+    EXPECT_EQ(ring.try_pop()->get(), 2);
+    EXPECT_FALSE(ring.try_pop().has_value());
+}
+
+TEST(RingBuffer, SharedMemoryHandoff) {
+    using Level = IntervalRefined<int, 0, 10>;
+    const std::string name = "/refinery_test_" + std::to_string(::getpid());
+    auto producer = SharedSpscRing<Level>::create(name, RingCapacity{8});
+    ASSERT_TRUE(producer.has_value());
+    auto consumer = SharedSpscRing<Level>::open(name);
+    ASSERT_TRUE(consumer.has_value());
+
+    // A live segment is never replaced under its peers
+    auto again = SharedSpscRing<Level>::create(name, RingCapacity{16});
+    ASSERT_FALSE(again.has_value());
+    EXPECT_EQ(again.error(), std::errc::file_exists);
+    EXPECT_EQ(consumer->capacity(), 8u);
+
+    EXPECT_TRUE(producer->try_push(Level{7}));
+    EXPECT_TRUE(producer->try_push(Level{3}));
+    EXPECT_EQ(consumer->try_pop()->get(), 7);
+    EXPECT_EQ(consumer->try_pop()->get(), 3);
+    EXPECT_FALSE(consumer->try_pop().has_value());
+
+    // A different predicate over the same type is refused
+    auto wrong = SharedSpscRing<IntervalRefined<int, 0, 11>>::open(name);
+    ASSERT_FALSE(wrong.has_value());
+    EXPECT_EQ(wrong.error(), std::errc::invalid_argument);
+
+    EXPECT_FALSE(SharedSpscRing<Level>::remove(name));
+    EXPECT_FALSE(SharedSpscRing<Level>::open(name).has_value());
+}
+
+TEST(RingBuffer, SharedMemoryRejectsOversizedCapacity) {
+    using Level = IntervalRefined<int, 0, 10>;
+    const std::string name = "/refinery_cap_" + std::to_string(::getpid());
+    ASSERT_TRUE(SharedSpscRing<Level>::create(name, RingCapacity{8}));
+
+    // Claim a capacity whose byte size wraps around to something small;
+    // the header's third word is the capacity
+    int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+    ASSERT_GE(fd, 0);
+    void* base = ::mmap(nullptr, 4096, PROT_READ | PROT_WRITE, MAP_SHARED,
+                        fd, 0);
+    ::close(fd);
+    ASSERT_NE(base, MAP_FAILED);
+    static_cast<std::uint64_t*>(base)[2] = std::uint64_t{1} << 62;
+    ::munmap(base, 4096);
+
+    auto ring = SharedSpscRing<Level>::open(name);
+    ASSERT_FALSE(ring.has_value());
+    EXPECT_EQ(ring.error(), std::errc::invalid_argument);
+    EXPECT_FALSE(SharedSpscRing<Level>::remove(name));
+}
+
+namespace {
+
+// Same text, different lambda-expressions
+inline constexpr auto small_a = [](int v) constexpr { return v < 8; };
+inline constexpr auto small_b = [](int v) constexpr { return v < 8; };
+
+struct SmallA {
+    Refined<int, small_a> value;
+};
+
+struct SmallB {
+    Refined<int, small_b> value;
+};
+
+} // namespace
+
+TEST(RingBuffer, LambdaPredicatesFingerprintApart) {
+    static_assert(type_fingerprint<Refined<int, Positive>> !=
+                  type_fingerprint<Refined<int, NonZero>>);
+    static_assert(type_fingerprint<Refined<int, small_a>> !=
+                  type_fingerprint<Refined<int, small_b>>);
+    static_assert(type_fingerprint<std::vector<Refined<int, small_a>>> !=
+                  type_fingerprint<std::vector<Refined<int, small_b>>>);
+    static_assert(type_fingerprint<Refined<int, small_a>> ==
+                  type_fingerprint<Refined<int, small_a>>);
+    static_assert(wire_schema_v<SmallA> != wire_schema_v<SmallB>);
+}
+
+// ---- Bulk Validation Tests ----
+
+TEST(BulkValidation, PoolRunsEveryChunkOnce) {
+    WorkStealingPool pool(3);
+    EXPECT_EQ(pool.size(), 3u);
+    std::vector<std::atomic<int>> runs(1000);
+    EXPECT_TRUE(pool.for_each_chunk(runs.size(), [&](std::size_t c) {
+        ++runs[c];
+        return true;
+    }));
+    EXPECT_TRUE(std::ranges::all_of(runs, [](const auto& r) {
+        return r.load() == 1;
+    }));
+
+    std::atomic<int> ran{0};
+    EXPECT_FALSE(pool.for_each_chunk(1000, [&](std::size_t c) {
+        ++ran;
+        return c != 0;
+    }));
+    EXPECT_LT(ran.load(), 1000);
+}
+
+TEST(BulkValidation, ParallelMatchesSequential) {
+    std::vector<std::int32_t> raw(100'000);
+    for (std::size_t i = 0; i < raw.size(); ++i)
+        raw[i] = static_cast<std::int32_t>(i % 97 == 0 ? -1 : i + 1);
+    const std::span<const std::int32_t> all(raw);
+
+    WorkStealingPool pool(4);
+    EXPECT_FALSE(all_valid<PositiveI32>(all));
+    EXPECT_FALSE(all_valid<PositiveI32>(pool, all));
+    EXPECT_EQ(count_invalid<PositiveI32>(all), (raw.size() + 96) / 97);
+    EXPECT_EQ(count_invalid<PositiveI32>(pool, all),
+              count_invalid<PositiveI32>(all));
+    EXPECT_FALSE(refine_all<PositiveI32>(pool, all).has_value());
+
+    auto sequential = partition_valid<PositiveI32>(all);
+    auto parallel = partition_valid<PositiveI32>(pool, all);
+    EXPECT_EQ(parallel.rejected, sequential.rejected);
+    ASSERT_EQ(parallel.values.size(), sequential.values.size());
+    EXPECT_TRUE(std::ranges::equal(parallel.values, sequential.values,
+                                   [](PositiveI32 a, PositiveI32 b) {
+                                       return a.get() == b.get();
+                                   }));
+    EXPECT_EQ(parallel.rejected.front(), 0u);
+    EXPECT_EQ(parallel.rejected[1], 97u);
+
+    auto valid = all.subspan(1, 96);
+    auto refined = refine_all<PositiveI32>(pool, valid);
+    ASSERT_TRUE(refined.has_value());
+    EXPECT_EQ(refined->size(), 96u);
+    EXPECT_EQ(refined->back().get(), 97);
+}
+
+// ---- Streaming Sequence Tests ----
+
+TEST(StreamValidation, SequencePredicatesRefineRanges) {
+    const std::vector<int> rising = {1, 2, 2, 5};
+    EXPECT_TRUE(Sorted(rising));
+    EXPECT_FALSE(StrictlySorted(rising));
+    EXPECT_FALSE(NoAdjacentDuplicates(rising));
+    EXPECT_TRUE(StrictlySorted(std::vector<int>{}));
+
+    using Ids = Refined<std::span<const int>, Sorted>;
+    EXPECT_TRUE(try_refine<Ids>(std::span<const int>(rising)).has_value());
+    const std::array<int, 3> falling = {3, 2, 1};
+    EXPECT_FALSE(try_refine<Ids>(std::span<const int>(falling)).has_value());
+
+    constexpr RunningSumWithin<0, 10> budget{};
+    EXPECT_TRUE(budget(std::vector<int>{4, 6, -10, 10}));
+    EXPECT_FALSE(budget(std::vector<int>{4, 7}));
+    EXPECT_FALSE(budget(std::vector<int>{-1, 1}));
+
+    // Bounds and elements of different signedness compare by value
+    constexpr RunningSumWithin<-5, 100> unsigned_budget{};
+    EXPECT_TRUE(unsigned_budget(std::vector<unsigned>{3, 50}));
+    EXPECT_FALSE(unsigned_budget(std::vector<unsigned>{60, 50}));
+    constexpr RunningSumWithin<0u, 10u> signed_budget{};
+    EXPECT_TRUE(signed_budget(std::vector<int>{5, -3, 8}));
+    EXPECT_FALSE(signed_budget(std::vector<int>{-1, 1}));
+}
+
+TEST(StreamValidation, FailuresAcrossChunkBoundaries) {
+    StreamValidator<int, StrictlySorted> strict;
+    const int first[] = {1, 3, 5};
+    const int second[] = {5, 6};
+    EXPECT_TRUE(strict.feed(first));
+    EXPECT_FALSE(strict.feed(second));
+    EXPECT_FALSE(strict.feed(first));
+    ASSERT_FALSE(strict.finish().has_value());
+    EXPECT_EQ(strict.finish().error().index, 3u);
+
+    StreamValidator<std::int64_t, RunningSumWithin<std::int64_t{0},
+                                                   std::int64_t{100}>{}>
+        balance;
+    std::vector<std::int64_t> deposits(1000, 1);
+    deposits[500] = -600;
+    EXPECT_FALSE(balance.feed(std::span(deposits).first(200)) &&
+                 balance.feed(std::span(deposits).subspan(200)));
+    EXPECT_EQ(balance.finish().error().index, 100u);
+}
+
+template <typename V>
+concept finishes_untagged =
+    requires(const V& v, std::span<const typename V::value_type> fed) {
+        v.finish(fed);
+    };
+
+TEST(StreamValidation, FinishYieldsRefinedView) {
+    std::vector<double> buffer(10'000);
+    for (std::size_t i = 0; i < buffer.size(); ++i)
+        buffer[i] = static_cast<double>(i / 3);
+
+    StreamValidator<double, Sorted> check;
+    for (std::size_t at = 0; at < buffer.size(); at += 777) {
+        std::size_t n = std::min<std::size_t>(777, buffer.size() - at);
+        ASSERT_TRUE(check.feed(std::span(buffer).subspan(at, n)));
+    }
+    EXPECT_EQ(check.finish().value(), buffer.size());
+    // The buffer is trusted to hold what was fed, so the caller says so
+    static_assert(!finishes_untagged<decltype(check)>);
+    auto view = check.finish(buffer, assume_valid);
+    ASSERT_TRUE(view.has_value());
+    static_assert(std::same_as<decltype(view)::value_type,
+                               Refined<std::span<const double>, Sorted>>);
+    EXPECT_EQ(view->get().size(), buffer.size());
+    EXPECT_FALSE(check.finish(std::span(buffer).first(10), assume_valid)
+                     .has_value());
+
+    StreamValidator<double, NoAdjacentDuplicates> distinct;
+    EXPECT_FALSE(distinct.feed(buffer));
+    EXPECT_EQ(distinct.finish().error().index, 1u);
+}
+
+// ---- Memory-Mapped Array Tests ----
+
+namespace {
+
+// A file in the temporary directory, removed when the test ends
+struct TempFile {
+    std::filesystem::path path;
+
+    explicit TempFile(std::string_view tag)
+        : path(std::filesystem::temp_directory_path() /
+               ("refinery_" + std::string(tag) + "_" +
+                std::to_string(::getpid()))) {}
+    ~TempFile() { std::filesystem::remove(path); }
+
+    template <typename T> void write(std::span<const T> values) const {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(values.data()),
+                  static_cast<std::streamsize>(values.size_bytes()));
+    }
+};
+
+} // namespace
+
+TEST(MappedArray, ViewsValidFileInPlace) {
+    TempFile file("mapped");
+    std::vector<std::int32_t> raw(1'500'000);
+    for (std::size_t i = 0; i < raw.size(); ++i)
+        raw[i] = static_cast<std::int32_t>(i % 1000 + 1);
+    file.write(std::span<const std::int32_t>(raw));
+
+    WorkStealingPool pool(3);
+    auto mapped = MappedArray<PositiveI32>::open(file.path, pool);
+    ASSERT_TRUE(mapped.has_value());
+    static_assert(std::same_as<decltype(mapped->values()),
+                               std::span<const PositiveI32>>);
+    ASSERT_EQ(mapped->size(), raw.size());
+    EXPECT_EQ((*mapped)[999].get(), 1000);
+    EXPECT_EQ(mapped->values().back().get(), raw.back());
+
+    auto sequential = MappedArray<PositiveI32>::open(file.path);
+    ASSERT_TRUE(sequential.has_value());
+    EXPECT_EQ(sequential->size(), raw.size());
+}
+
+TEST(MappedArray, ReportsFirstInvalidElement) {
+    TempFile file("mapped_bad");
+    std::vector<std::int32_t> raw(1'500'000, 7);
+    raw[1'400'000] = 0;
+    raw[900'000] = -3;
+    file.write(std::span<const std::int32_t>(raw));
+
+    WorkStealingPool pool(4);
+    auto expect_index = [](const auto& mapped) {
+        ASSERT_FALSE(mapped.has_value());
+        EXPECT_EQ(mapped.error().reason,
+                  mapped_array_error::kind::predicate_failed);
+        EXPECT_EQ(mapped.error().index, 900'000u);
+    };
+    expect_index(MappedArray<PositiveI32>::open(file.path, pool));
+    expect_index(MappedArray<PositiveI32>::open(file.path));
+
+    const std::int8_t odd[] = {1, 2, 3};
+    file.write(std::span<const std::int8_t>(odd));
+    auto truncated = MappedArray<PositiveI32>::open(file.path);
+    ASSERT_FALSE(truncated.has_value());
+    EXPECT_EQ(truncated.error().reason, mapped_array_error::kind::bad_size);
+
+    auto missing = MappedArray<PositiveI32>::open(file.path / "missing");
+    ASSERT_FALSE(missing.has_value());
+    EXPECT_EQ(missing.error().reason, mapped_array_error::kind::io);
+}
+
+// ---- Snapshot Tests ----
+
+TEST(Snapshot, ReloadsUnderEveryCheck) {
+    using Level = IntervalRefined<std::int16_t, std::int16_t{0},
+                                  std::int16_t{500}>;
+    TempFile file("snapshot");
+    std::vector<Level> levels;
+    for (int i = 0; i < 10'001; ++i) {
+        auto level = static_cast<std::int16_t>(i % 501);
+        levels.push_back(Level(level, assume_valid));
+    }
+    ASSERT_FALSE(write_snapshot(file.path, std::span<const Level>(levels)));
+    EXPECT_EQ(std::filesystem::file_size(file.path),
+              64 + levels.size() * sizeof(Level));
+
+    for (auto check : {snapshot_check::full, snapshot_check::checksum,
+                       snapshot_check::header}) {
+        auto loaded = Snapshot<Level>::open(file.path, check);
+        ASSERT_TRUE(loaded.has_value());
+        ASSERT_EQ(loaded->size(), levels.size());
+        EXPECT_TRUE(std::ranges::equal(loaded->values(), levels));
+    }
+}
+
+TEST(Snapshot, RejectsMismatchesAndDamage) {
+    using Level = IntervalRefined<std::int16_t, std::int16_t{0},
+                                  std::int16_t{500}>;
+    TempFile file("snapshot_bad");
+    const std::vector<Level> levels(4096, Level{250});
+    ASSERT_FALSE(write_snapshot(file.path, std::span<const Level>(levels)));
+
+    using Wider = IntervalRefined<std::int16_t, std::int16_t{0},
+                                  std::int16_t{1000}>;
+    EXPECT_EQ(Snapshot<Wider>::open(file.path).error().reason,
+              snapshot_error::kind::bounds_mismatch);
+    EXPECT_EQ(Snapshot<PositiveI32>::open(file.path).error().reason,
+              snapshot_error::kind::type_mismatch);
+
+    // Flip one payload byte to 0xff: value 250 becomes out of range
+    {
+        std::fstream f(file.path, std::ios::in | std::ios::out |
+                                      std::ios::binary);
+        f.seekp(64 + 2 * 1000 + 1);
+        f.put(static_cast<char>(0xff));
+    }
+    EXPECT_EQ(Snapshot<Level>::open(file.path).error().reason,
+              snapshot_error::kind::checksum_mismatch);
+    EXPECT_EQ(
+        Snapshot<Level>::open(file.path, snapshot_check::full).error().reason,
+        snapshot_error::kind::checksum_mismatch);
+    // Trusting the header alone skips the payload entirely
+    EXPECT_TRUE(
+        Snapshot<Level>::open(file.path, snapshot_check::header).has_value());
+
+    const char junk[] = "not a snapshot";
+    file.write(std::span<const char>(junk));
+    EXPECT_EQ(Snapshot<Level>::open(file.path).error().reason,
+              snapshot_error::kind::bad_header);
+}
+
+// ---- Wire Format Tests ----
+
+namespace {
+
+struct Handshake {
+    IntervalRefined<std::uint8_t, 1, 4> version;
+    PortNumber<std::uint16_t> port;
+};
+
+std::vector<Fill> sample_fills() {
+    return {Fill{IntervalRefined<std::uint8_t, 1, 4>{2},
+                 PortNumber<std::uint16_t>{8080}, 150, PositiveF64{99.5},
+                 Side::sell, true},
+            Fill{IntervalRefined<std::uint8_t, 1, 4>{4},
+                 PortNumber<std::uint16_t>{443}, 7, PositiveF64{0.25},
+                 Side::buy, false}};
+}
+
+} // namespace
+
+TEST(WireFormat, RoundTripsUnderBothPolicies) {
+    static_assert(wire_schema_v<Fill> != wire_schema_v<Fill, std::endian::big>);
+    const auto fills = sample_fills();
+    std::vector<std::byte> frame;
+    encode_frame<Fill>(fills, frame);
+    ASSERT_EQ(frame.size(), wire_header_size + 2 * wire_size_v<Fill>);
+    EXPECT_EQ(frame_size(frame), frame.size());
+
+    // The records use decode.hpp's layout
+    auto first = decode<Fill>(std::span(frame).subspan(wire_header_size));
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->port.get(), 8080);
+
+    for (auto trust : {wire_trust::validate, wire_trust::trusted}) {
+        std::vector<Fill> out;
+        auto used = decode_frame<Fill>(frame, trust, out);
+        ASSERT_TRUE(used.has_value());
+        EXPECT_EQ(*used, frame.size());
+        ASSERT_EQ(out.size(), 2u);
+        EXPECT_EQ(out[1].version.get(), 4);
+        EXPECT_EQ(out[1].price.get(), 0.25);
+        EXPECT_EQ(out[1].side, Side::buy);
+        EXPECT_FALSE(out[1].last);
+    }
+
+    std::vector<std::byte> big;
+    encode_frame<Fill, std::endian::big>(fills, big);
+    std::vector<Fill> out;
+    ASSERT_TRUE((decode_frame<Fill, std::endian::big>(big, wire_trust::validate,
+                                                      out)
+                     .has_value()));
+    EXPECT_EQ(out[0].quantity, 150);
+}
+
+TEST(WireFormat, TrustDecidesWhoChecks) {
+    auto fills = sample_fills();
+    // A faulty sender that never checked its port
+    fills[1].port = PortNumber<std::uint16_t>(0, assume_valid);
+    std::vector<std::byte> frame;
+    encode_frame<Fill>(fills, frame);
+
+    std::vector<Fill> out;
+    auto checked = decode_frame<Fill>(frame, wire_trust::validate, out);
+    ASSERT_FALSE(checked.has_value());
+    EXPECT_EQ(checked.error().reason, wire_error::kind::invalid_record);
+    EXPECT_EQ(checked.error().record, 1u);
+    EXPECT_EQ(checked.error().cause.field, "port");
+    EXPECT_TRUE(out.empty());
+
+    EXPECT_TRUE(
+        decode_frame<Fill>(frame, wire_trust::trusted, out).has_value());
+    EXPECT_EQ(out.size(), 2u);
+}
+
+TEST(WireFormat, RejectsOtherSchemasAndShortInput) {
+    std::vector<std::byte> frame;
+    encode_frame<Fill>(sample_fills(), frame);
+
+    std::vector<Handshake> handshakes;
+    auto other =
+        decode_frame<Handshake>(frame, wire_trust::trusted, handshakes);
+    ASSERT_FALSE(other.has_value());
+    EXPECT_EQ(other.error().reason, wire_error::kind::schema_mismatch);
+
+    std::vector<Fill> out;
+    auto cut = std::span(frame).first(frame.size() - 1);
+    EXPECT_EQ(decode_frame<Fill>(cut, wire_trust::trusted, out).error().reason,
+              wire_error::kind::truncated);
+    EXPECT_FALSE(frame_size(std::span(frame).first(8)).has_value());
+}
+
+// ---- Refined Byte Buffer Tests ----
+
+namespace {
+
+std::vector<std::byte> packet_bytes(std::initializer_list<int> values) {
+    std::vector<std::byte> out;
+    for (int v : values)
+        out.push_back(static_cast<std::byte>(v));
+    return out;
+}
+
+template <typename B, std::size_t K>
+concept can_read_at = requires(B b) { b.template read<std::uint32_t, K>(); };
+
+template <typename B, std::size_t K>
+concept can_advance = requires(B b) { b.template advance<K>(); };
+
+} // namespace
+
+TEST(RefinedBytes, FixedReadsWithinTheCheckedPrefix) {
+    // kind 0x0102, port 8080, then a little-endian 32-bit sequence number
+    auto buffer = packet_bytes({0x01, 0x02, 0x1f, 0x90, 0x78, 0x56, 0x34,
+                                0x12, 0xaa});
+    EXPECT_FALSE(refine_bytes<10>(buffer).has_value());
+    auto packet = refine_bytes<8>(buffer);
+    ASSERT_TRUE(packet.has_value());
+    EXPECT_EQ(packet->size(), 9u);
+
+    EXPECT_EQ((packet->read<std::uint16_t, 0, std::endian::big>()), 0x0102);
+    EXPECT_EQ((packet->read<std::uint16_t, 0, std::endian::little>()),
+              0x0201);
+    EXPECT_EQ((packet->read<std::uint32_t, 4>()), 0x12345678u);
+    EXPECT_EQ((packet->read<std::uint8_t, 7>()), 0x12);
+
+    auto port =
+        packet->read_refined<PortNumber<std::uint16_t>, 2, std::endian::big>();
+    ASSERT_TRUE(port.has_value());
+    EXPECT_EQ(port->get(), 8080);
+    EXPECT_FALSE((packet->read_refined<Refined<std::uint16_t, Zero>, 2,
+                                       std::endian::big>()
+                      .has_value()));
+
+    static_assert(can_read_at<RefinedBytes<8>, 4>);
+    static_assert(!can_read_at<RefinedBytes<8>, 5>);
+    static_assert(!can_advance<RefinedBytes<8>, 9>);
+}
+
+TEST(RefinedBytes, SplitAndAdvanceCarryTheGuarantee) {
+    auto buffer = packet_bytes({1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+    RefinedBytes<8> packet = *refine_bytes<8>(buffer);
+
+    RefinedBytes<5> rest = packet.advance<3>();
+    EXPECT_EQ(rest.size(), 7u);
+    EXPECT_EQ((rest.read<std::uint8_t, 4>()), 8);
+
+    auto [head, tail] = packet.split<2>();
+    static_assert(std::same_as<decltype(head), RefinedBytes<2>>);
+    static_assert(std::same_as<decltype(tail), RefinedBytes<6>>);
+    EXPECT_EQ(head.size(), 2u);
+    EXPECT_EQ(tail.size(), 8u);
+    EXPECT_EQ((tail.read<std::uint16_t, 0, std::endian::big>()), 0x0304);
+
+    std::span<const std::byte, 3> first = packet.first<3>();
+    EXPECT_EQ(first[2], std::byte{3});
+    EXPECT_EQ((packet.subspan<6, 2>()[1]), std::byte{8});
+
+    RefinedBytes<4> weaker = packet;
+    EXPECT_EQ(weaker.size(), 10u);
+    EXPECT_FALSE(packet.require<11>().has_value());
+    ASSERT_TRUE(packet.require<10>().has_value());
+
+    std::array<std::byte, 4> fixed{};
+    RefinedBytes<4> from_array = std::span<const std::byte, 4>(fixed);
+    EXPECT_EQ(from_array.size(), 4u);
+}
+
+TEST(RefinedBytes, TakeChecksVariableSectionsOnce) {
+    // 2-byte length, payload, then a 2-byte trailer
+    auto buffer = packet_bytes({0, 3, 'a', 'b', 'c', 0xbe, 0xef});
+    auto packet = refine_bytes<2>(buffer);
+    ASSERT_TRUE(packet.has_value());
+    auto length = packet->read<std::uint16_t, 0, std::endian::big>();
+
+    auto body = packet->advance<2>().take<2>(length);
+    ASSERT_TRUE(body.has_value());
+    auto [payload, trailer] = *body;
+    EXPECT_EQ(payload.size(), 3u);
+    EXPECT_EQ(payload[0], std::byte{'a'});
+    EXPECT_EQ((trailer.read<std::uint16_t, 0, std::endian::big>()), 0xbeef);
+
+    EXPECT_FALSE(packet->advance<2>().take<3>(length).has_value());
+    EXPECT_FALSE(packet->advance<2>().take(6).has_value());
+    EXPECT_TRUE(packet->advance<2>().take(5).has_value());
+}
+
+// ---- Alignment Refinement Tests ----
+
+TEST(Aligned, ChecksPointersAndSpans) {
+    alignas(64) static float buffer[32] = {};
+    EXPECT_TRUE(Aligned<64>(&buffer[0]));
+    EXPECT_TRUE(Aligned<16>(&buffer[4]));
+    EXPECT_FALSE(Aligned<64>(&buffer[4]));
+    EXPECT_TRUE(Aligned<64>(std::span<float>(buffer)));
+    EXPECT_FALSE(Aligned<8>(std::span<float>(buffer).subspan(1)));
+
+    EXPECT_TRUE((try_refine<AlignedPtr<float, 64>>(buffer).has_value()));
+    EXPECT_FALSE(
+        (try_refine<AlignedPtr<float, 64>>(buffer + 1).has_value()));
+    float* null = nullptr;
+    EXPECT_FALSE((try_refine<AlignedPtr<float, 64>>(null).has_value()));
+    EXPECT_THROW((AlignedSpan<float, 32>(std::span<float>(buffer).subspan(2),
+                                         runtime_check)),
+                 refinement_error);
+}
+
+TEST(Aligned, AccessorsCarryTheAlignment) {
+    static_assert(alignment_of_v<Aligned<32>> == 32);
+    static_assert(alignment_of_v<All<NotNull, Aligned<64>>> == 64);
+    static_assert(alignment_of_v<NotNull> == 1);
+
+    alignas(64) static float buffer[16] = {};
+    AlignedPtr<float, 64> p(buffer, runtime_check);
+    EXPECT_EQ(aligned_data(p), buffer);
+
+    AlignedSpan<float, 64> s(std::span<float>(buffer), runtime_check);
+    EXPECT_EQ(aligned_data(s), buffer);
+    EXPECT_EQ(aligned_span(s).size(), 16u);
+
+    // Stronger alignment converts to weaker, not the other way round
+    static_assert(
+        std::is_convertible_v<AlignedSpan<float, 64>, AlignedSpan<float, 16>>);
+    static_assert(
+        !std::is_convertible_v<AlignedSpan<float, 16>, AlignedSpan<float, 64>>);
+    AlignedSpan<float, 16> weaker = s;
+    EXPECT_EQ(aligned_data(weaker), buffer);
+}
+
+TEST(Aligned, AlignedPtrConvertsToWeakerGuarantees) {
+    static_assert(
+        std::is_convertible_v<AlignedPtr<float, 64>, AlignedPtr<float, 16>>);
+    static_assert(
+        !std::is_convertible_v<AlignedPtr<float, 16>, AlignedPtr<float, 64>>);
+    static_assert(std::is_convertible_v<AlignedPtr<float, 64>,
+                                        Refined<float*, Aligned<32>>>);
+    static_assert(!std::is_convertible_v<AlignedPtr<float, 16>,
+                                         Refined<float*, Aligned<32>>>);
+    static_assert(std::is_convertible_v<AlignedPtr<float, 64>,
+                                        Refined<float*, NotNull>>);
+
+    alignas(64) static float buffer[16] = {};
+    AlignedPtr<float, 64> p(buffer, runtime_check);
+    AlignedPtr<float, 16> weaker = p;
+    EXPECT_EQ(aligned_data(weaker), buffer);
+}
+
+// ---- Chunked Span Tests ----
+
+TEST(ChunkedSpan, SplitsIntoRefinedBodyAndTail) {
+    std::vector<int> values(19);
+    for (int i = 0; i < 19; ++i)
+        values[i] = i;
+    auto [body, tail] = split_chunks<8>(std::span(values));
+    EXPECT_EQ(body->size(), 16u);
+    EXPECT_EQ(tail.size(), 3u);
+    EXPECT_EQ(tail[0], 16);
+
+    EXPECT_TRUE(SizeDivisibleBy<4>(std::vector<int>(12)));
+    EXPECT_FALSE(SizeDivisibleBy<4>(std::vector<int>(10)));
+    EXPECT_FALSE((try_refine<ChunkedSpan<int, 8>>(std::span(values))
+                      .has_value()));
+}
+
+TEST(ChunkedSpan, VisitsExactChunksInOrder) {
+    std::array<int, 12> values{};
+    for (int i = 0; i < 12; ++i)
+        values[i] = i;
+    ChunkedSpan<int, 4> s(std::span<int>(values), runtime_check);
+
+    std::vector<int> firsts;
+    for_each_chunk<4>(s, [&](std::span<int, 4> chunk) {
+        firsts.push_back(chunk[0]);
+        for (int& x : chunk)
+            x *= 2;
+    });
+    EXPECT_EQ(firsts, (std::vector<int>{0, 4, 8}));
+    EXPECT_EQ(values[11], 22);
+
+    // Any divisor of the refined multiple also chunks exactly
+    int pairs = 0;
+    for_each_chunk<2>(s, [&](std::span<int, 2>) { ++pairs; });
+    EXPECT_EQ(pairs, 6);
+    ChunkedSpan<int, 2> coarse = s;
+    EXPECT_EQ(coarse->size(), 12u);
+    static_assert(
+        !std::is_convertible_v<ChunkedSpan<int, 2>, ChunkedSpan<int, 4>>);
+}
+
+TEST(ChunkedSpan, SubspansStayOnChunkBoundaries) {
+    std::array<int, 16> values{};
+    for (int i = 0; i < 16; ++i)
+        values[i] = i;
+    ChunkedSpan<int, 4> s(std::span<int>(values), runtime_check);
+
+    auto middle = chunk_subspan<4>(s, 1, 2);
+    static_assert(std::same_as<decltype(middle), ChunkedSpan<int, 4>>);
+    EXPECT_EQ(middle->size(), 8u);
+    EXPECT_EQ(middle->front(), 4);
+    auto rest = chunk_subspan<4>(s, 3);
+    EXPECT_EQ(rest->size(), 4u);
+    EXPECT_EQ(rest->back(), 15);
+}
+
+TEST(ChunkedSpan, SubspanOfADivisorKeepsOnlyTheDivisor) {
+    std::vector<int> values(32);
+    ChunkedSpan<int, 16> s(std::span<int>(values), runtime_check);
+
+    // One 8-wide chunk of a multiple of 16 is not a multiple of 16
+    auto one = chunk_subspan<8>(s, 0, 1);
+    static_assert(std::same_as<decltype(one), ChunkedSpan<int, 8>>);
+    EXPECT_EQ(one->size(), 8u);
+    EXPECT_TRUE(SizeDivisibleBy<8>(one.get()));
+    EXPECT_FALSE(SizeDivisibleBy<16>(one.get()));
+}
+
+TEST(ChunkedSpan, SubspanOfAFixedSpanIsNotFixed) {
+    std::array<int, 16> values{};
+    FixedSpan<int, 16> s = refine_fixed(std::span(values));
+
+    auto middle = chunk_subspan<4>(s, 1, 2);
+    static_assert(std::same_as<decltype(middle), ChunkedSpan<int, 4>>);
+    EXPECT_EQ(middle->size(), 8u);
+    EXPECT_EQ(middle->data(), values.data() + 4);
+}
+
+// ---- Bounded Container Tests ----
+
+TEST(BoundedVector, ConvertsFromBoundedRefinementsWithoutChecks) {
+    using AtMost4 = Refined<std::vector<int>, SizeAtMost(4)>;
+    static_assert(std::is_convertible_v<AtMost4, BoundedVector<int, 4>>);
+    static_assert(std::is_convertible_v<AtMost4, BoundedVector<int, 8>>);
+    static_assert(!std::is_convertible_v<AtMost4, BoundedVector<int, 3>>);
+    static_assert(std::is_convertible_v<
+                  Refined<std::vector<int>, SizeInRange(1, 3)>,
+                  BoundedVector<int, 3>>);
+    static_assert(std::is_convertible_v<
+                  Refined<std::vector<int>, SizeExactly(2)>,
+                  BoundedVector<int, 2>>);
+    static_assert(!std::is_convertible_v<
+                  Refined<std::vector<int>, SizeAtLeast(2)>,
+                  BoundedVector<int, 8>>);
+    static_assert(!std::is_convertible_v<std::vector<int>,
+                                         BoundedVector<int, 8>>);
+
+    AtMost4 refined(std::vector<int>{1, 2, 3}, runtime_check);
+    BoundedVector<int, 4> inline_copy = refined;
+    EXPECT_EQ(inline_copy.size(), 3u);
+    EXPECT_EQ(inline_copy[2], 3);
+
+    auto back = inline_copy.to_vector();
+    static_assert(std::same_as<decltype(back),
+                               Refined<std::vector<int>, SizeAtMost(4)>>);
+    EXPECT_EQ(back->size(), 3u);
+
+    std::vector<int> five{1, 2, 3, 4, 5};
+    EXPECT_FALSE((BoundedVector<int, 4>::from(five).has_value()));
+    EXPECT_TRUE((BoundedVector<int, 5>::from(five).has_value()));
+}
+
+TEST(BoundedVector, PushesUpToCapacity) {
+    BoundedVector<std::string, 2> names;
+    names.push_back("alpha");
+    EXPECT_TRUE(names.try_push_back("beta"));
+    EXPECT_FALSE(names.try_push_back("gamma"));
+    EXPECT_THROW(names.push_back("gamma"), refinement_error);
+    EXPECT_EQ(names.size(), 2u);
+
+    BoundedVector<std::string, 2> copy = names;
+    names.pop_back();
+    EXPECT_EQ(names.size(), 1u);
+    EXPECT_EQ(copy[1], "beta");
+    copy = names;
+    EXPECT_EQ(copy.size(), 1u);
+    EXPECT_EQ(copy, names);
+
+    std::array<int, 3> fixed{7, 8, 9};
+    BoundedVector<int, 4> from_span{std::span<const int, 3>(fixed)};
+    EXPECT_EQ(from_span.size(), 3u);
+}
+
+TEST(BoundedString, AppendsInlineAndConverts) {
+    BoundedString<8> symbol = "AAPL";
+    EXPECT_EQ(symbol.view(), "AAPL");
+    EXPECT_TRUE(symbol.try_append(".O"));
+    EXPECT_FALSE(symbol.try_append("XXX"));
+    EXPECT_EQ(symbol, "AAPL.O");
+    symbol.push_back('!');
+    symbol.push_back('!');
+    EXPECT_THROW(symbol.push_back('!'), refinement_error);
+
+    Refined<std::string, SizeAtMost(8)> refined(std::string("MSFT"),
+                                                runtime_check);
+    BoundedString<8> from_refined = refined;
+    EXPECT_EQ(from_refined.to_string().get(), "MSFT");
+    EXPECT_FALSE(BoundedString<3>::from("MSFT").has_value());
+    static_assert(
+        !std::is_constructible_v<BoundedString<3>, const char (&)[5]>);
+}
+
+// ---- Fixed Size Tests ----
+
+TEST(FixedSize, ConvertsToFixedExtentsWithoutCopying) {
+    using Block = Refined<std::vector<float>, FixedSize<4>>;
+    EXPECT_FALSE(try_refine<Block>(std::vector<float>(3)).has_value());
+    Block block(std::vector<float>{1, 2, 3, 4}, runtime_check);
+
+    auto view = fixed_span(block);
+    static_assert(std::same_as<decltype(view), std::span<const float, 4>>);
+    EXPECT_EQ(view.data(), block->data());
+    EXPECT_EQ(view[3], 4.0f);
+}
+
+TEST(FixedSize, FixedSpansRoundTrip) {
+    std::array<int, 8> values{1, 2, 3, 4, 5, 6, 7, 8};
+    FixedSpan<int, 8> s = refine_fixed(std::span(values));
+    static_assert(std::same_as<decltype(fixed_span(s)), std::span<int, 8>>);
+
+    // Spans do not own their elements, so the views stay writable
+    fixed_span(s)[0] = 10;
+    EXPECT_EQ(values[0], 10);
+
+    // An exact size is also a multiple of itself and of its divisors
+    static_assert(size_multiple_of_v<FixedSize<8>> == 8);
+    int chunks = 0;
+    for_each_chunk<4>(s, [&](std::span<int, 4>) { ++chunks; });
+    EXPECT_EQ(chunks, 2);
+}
+
+// ---- Non-Empty Algorithm Tests ----
+
+TEST(NonEmptyAlgorithms, AcceptOnlyRangesThatCannotBeEmpty) {
+    static_assert(non_empty_range<Refined<std::vector<int>, NonEmpty>>);
+    static_assert(
+        non_empty_range<Refined<std::vector<int>, SizeAtLeast(1)>>);
+    static_assert(
+        non_empty_range<Refined<std::span<const int>, SizeInRange(2, 4)>>);
+    static_assert(non_empty_range<Refined<std::span<int>, FixedSize<3>>>);
+    static_assert(
+        !non_empty_range<Refined<std::vector<int>, SizeAtLeast(0)>>);
+    static_assert(!non_empty_range<Refined<std::vector<int>, SizeAtMost(4)>>);
+    static_assert(!non_empty_range<std::vector<int>>);
+}
+
+TEST(NonEmptyAlgorithms, FrontBackMinMaxFold) {
+    Refined<std::vector<int>, NonEmpty> values(std::vector<int>{4, -2, 9, 1},
+                                               runtime_check);
+    EXPECT_EQ(refined_front(values), 4);
+    EXPECT_EQ(refined_back(values), 1);
+    EXPECT_EQ(refined_max(values), 9);
+    EXPECT_EQ(refined_min(values), -2);
+    EXPECT_EQ(refined_fold1(values, std::plus<>{}), 12);
+    EXPECT_EQ(refined_fold1(values, [](int a, int b) { return a * b; }),
+              -72);
+    EXPECT_DOUBLE_EQ(refined_mean(values), 3.0);
+    static_assert(std::same_as<decltype(refined_mean(values)), double>);
+
+    Refined<std::vector<int>, NonEmpty> single(std::vector<int>{7},
+                                               runtime_check);
+    EXPECT_EQ(refined_max(single), 7);
+    EXPECT_EQ(refined_fold1(single, std::plus<>{}), 7);
+}
+
+TEST(NonEmptyAlgorithms, ResultsKeepElementRefinements) {
+    std::vector<PositiveI32> raw{PositiveI32(3, assume_valid),
+                                 PositiveI32(8, assume_valid),
+                                 PositiveI32(5, assume_valid)};
+    Refined<std::vector<PositiveI32>, NonEmpty> values(raw, runtime_check);
+
+    auto most = refined_max(values);
+    static_assert(std::same_as<decltype(most), PositiveI32>);
+    EXPECT_EQ(most.get(), 8);
+    EXPECT_EQ(refined_min(values).get(), 3);
+
+    auto mean = refined_mean(values);
+    static_assert(
+        std::same_as<decltype(mean), Refined<double, PositiveI32::predicate>>);
+    EXPECT_DOUBLE_EQ(mean.get(), 16.0 / 3.0);
+
+    using Percent = IntervalRefined<int, 0, 100>;
+    std::array<Percent, 2> full{Percent(100, assume_valid),
+                                Percent(100, assume_valid)};
+    auto view = refine_fixed(std::span<const Percent, 2>(full));
+    EXPECT_EQ(refined_mean(view).get(), 100.0);
+}
+
+// ---- Sorted Range Tests ----
+
+TEST(SortedRanges, SortProducesRefinements) {
+    auto sorted = refined_sort(std::vector<int>{5, 1, 4, 1, 3});
+    static_assert(
+        std::same_as<decltype(sorted), Refined<std::vector<int>, Sorted>>);
+    EXPECT_EQ(sorted.get(), (std::vector<int>{1, 1, 3, 4, 5}));
+
+    auto unique = refined_sort_unique(std::vector<int>{5, 1, 4, 1, 3, 5});
+    EXPECT_EQ(unique.get(), (std::vector<int>{1, 3, 4, 5}));
+
+    // Strictly sorted ranges are sorted ranges
+    Refined<std::vector<int>, Sorted> widened = unique;
+    EXPECT_EQ(widened->size(), 4u);
+    static_assert(strictly_sorted_range<decltype(unique)>);
+    static_assert(sorted_range<decltype(unique)>);
+    static_assert(!strictly_sorted_range<decltype(sorted)>);
+    static_assert(!sorted_range<std::vector<int>>);
+    static_assert(!sorted_range<Refined<std::vector<int>, NonEmpty>>);
+}
+
+TEST(SortedRanges, BranchlessSearchMatchesStd) {
+    std::vector<int> values;
+    for (int i = 0; i < 200; ++i)
+        values.push_back(i / 3 * 2); // duplicates and gaps
+    Refined<std::span<const int>, Sorted> view(std::span<const int>(values),
+                                               runtime_check);
+    for (std::size_t n = 0; n <= values.size(); n += 37) {
+        Refined<std::span<const int>, Sorted> prefix(view->first(n),
+                                                     assume_valid);
+        for (int v = -2; v < 140; ++v) {
+            EXPECT_EQ(refined_lower_bound(prefix, v),
+                      std::ranges::lower_bound(*prefix, v));
+            EXPECT_EQ(refined_upper_bound(prefix, v),
+                      std::ranges::upper_bound(*prefix, v));
+            EXPECT_EQ(refined_contains(prefix, v),
+                      std::ranges::binary_search(*prefix, v));
+        }
+    }
+}
+
+TEST(SortedRanges, GallopingSetOperationsMatchStd) {
+    // One dense input, one sparse with runs, in both argument orders
+    std::vector<int> dense;
+    std::vector<int> sparse;
+    for (int i = 0; i < 300; ++i)
+        dense.push_back(i / 2);
+    for (int i = 0; i < 40; ++i)
+        sparse.push_back(i * i % 97 + (i % 5 == 0 ? 200 : 0));
+    auto a = refined_sort(dense);
+    auto b = refined_sort(sparse);
+
+    auto expect = [](auto op, const auto& x, const auto& y) {
+        std::vector<int> out;
+        op(*x, *y, std::back_inserter(out));
+        return out;
+    };
+    for (int pass = 0; pass < 2; ++pass) {
+        const auto& x = pass == 0 ? a : b;
+        const auto& y = pass == 0 ? b : a;
+        EXPECT_EQ(refined_merge(x, y).get(), expect(std::ranges::merge, x, y));
+        EXPECT_EQ(refined_set_intersection(x, y).get(),
+                  expect(std::ranges::set_intersection, x, y));
+        EXPECT_EQ(refined_set_union(x, y).get(),
+                  expect(std::ranges::set_union, x, y));
+        EXPECT_EQ(refined_set_difference(x, y).get(),
+                  expect(std::ranges::set_difference, x, y));
+    }
+
+    Refined<std::vector<int>, Sorted> empty(std::vector<int>{}, assume_valid);
+    EXPECT_EQ(refined_set_union(empty, a).get(), a.get());
+    EXPECT_TRUE(refined_set_intersection(a, empty)->empty());
+}
+
+TEST(SortedRanges, StrictInputsGiveStrictResults) {
+    auto odd = refined_sort_unique(std::vector<int>{9, 1, 5, 3, 7});
+    auto low = refined_sort_unique(std::vector<int>{1, 2, 3, 4});
+    auto dup = refined_sort(std::vector<int>{3, 3, 9});
+
+    auto both = refined_set_intersection(odd, low);
+    static_assert(std::same_as<decltype(both),
+                               Refined<std::vector<int>, StrictlySorted>>);
+    EXPECT_EQ(both.get(), (std::vector<int>{1, 3}));
+
+    auto all = refined_set_union(odd, low);
+    static_assert(std::same_as<decltype(all),
+                               Refined<std::vector<int>, StrictlySorted>>);
+    EXPECT_EQ(all.get(), (std::vector<int>{1, 2, 3, 4, 5, 7, 9}));
+
+    // Repeats in either union input may survive; intersection with a
+    // strictly sorted input cannot repeat
+    static_assert(std::same_as<decltype(refined_set_union(odd, dup)),
+                               Refined<std::vector<int>, Sorted>>);
+    static_assert(std::same_as<decltype(refined_set_intersection(dup, odd)),
+                               Refined<std::vector<int>, StrictlySorted>>);
+    static_assert(std::same_as<decltype(refined_merge(odd, low)),
+                               Refined<std::vector<int>, Sorted>>);
+    EXPECT_EQ(refined_set_difference(odd, low).get(),
+              (std::vector<int>{5, 7, 9}));
+}